@@ -0,0 +1,58 @@
+#include "AllocationCounter.h"
+
+#ifdef IMGUI_XML_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local std::size_t t_allocations = 0;
+
+void* counted_allocate(std::size_t size) {
+    ++t_allocations;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* counted_allocate(std::size_t size, std::align_val_t alignment) {
+    ++t_allocations;
+    // aligned_alloc needs the size to be a multiple of the alignment
+    auto align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = (size + align - 1) / align * align;
+    if (void* memory = std::aligned_alloc(align, rounded ? rounded : align)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+namespace allocation_counter {
+
+std::size_t thread_allocations() {
+    return t_allocations;
+}
+
+} // namespace allocation_counter
+
+// ============================================================================
+// Global Allocation Functions
+// ============================================================================
+
+void* operator new(std::size_t size) { return counted_allocate(size); }
+void* operator new[](std::size_t size) { return counted_allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return counted_allocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return counted_allocate(size, alignment); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief Debug count of heap allocations made by the calling thread
+ *
+ * Configure with -DIMGUI_XML_COUNT_ALLOCATIONS=ON to replace the global
+ * operator new with a counting one (AllocationCounter.cpp). PanelManager
+ * then asserts that steady-state frames render without allocating. In
+ * normal builds the counter always reads zero and costs nothing.
+ *
+ * Counts are per thread, so pool workers building panels in the background
+ * do not show up in the UI thread's frame.
+ */
+namespace allocation_counter {
+
+#ifdef IMGUI_XML_COUNT_ALLOCATIONS
+constexpr bool kEnabled = true;
+std::size_t thread_allocations();
+#else
+constexpr bool kEnabled = false;
+inline std::size_t thread_allocations() { return 0; }
+#endif
+
+} // namespace allocation_counter
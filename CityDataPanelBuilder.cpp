@@ -1,7 +1,5 @@
 #include "CityDataPanelBuilder.h"
 
-#include <algorithm>
-#include <array>
 #include <string>
 #include <utility>
 
@@ -19,8 +17,8 @@ CityDataPanelBuilder& CityDataPanelBuilder::with_size(float width, float height)
     return *this;
 }
 
-CityDataPanelBuilder& CityDataPanelBuilder::with_max_rows(std::size_t rows) {
-    max_rows_ = rows;
+CityDataPanelBuilder& CityDataPanelBuilder::with_min_rows(std::size_t rows) {
+    min_rows_ = rows;
     return *this;
 }
 
@@ -40,19 +38,16 @@ CityDataPanelBuilder& CityDataPanelBuilder::on_toggle_dpi(std::function<void()>
 }
 
 std::unique_ptr<Panel> CityDataPanelBuilder::build() {
-    ensure_minimum_city_entries(max_rows_);
+    ensure_minimum_city_entries(min_rows_);
 
     auto panel = std::make_unique<Panel>(title_, width_, height_);
+    WidgetArena::Scope arena_scope(panel->get_widget_arena());
 
     VLayoutBuilder root("main_layout");
     root.padding(10.0f).gap(15.0f);
 
     root.add_child(build_title_section());
-    std::size_t row_count = std::min(max_rows_, data_.cities.size());
-    for (std::size_t i = 0; i < row_count; ++i) {
-        root.add_child(build_city_row(i, data_.cities[i]));
-    }
-
+    root.add_child(build_city_table());
     root.add_child(build_button_row());
 
     panel->set_root_widget(root.build());
@@ -79,39 +74,18 @@ std::unique_ptr<Widget> CityDataPanelBuilder::build_title_section() {
     return row.build();
 }
 
-std::unique_ptr<Widget> CityDataPanelBuilder::build_city_row(std::size_t index, CityData& city) {
-    const std::string idx = std::to_string(index);
-
-    HLayoutBuilder row("row_" + idx);
-    row.justify("space-between").align("center").gap(10.0f);
-
-    row.add_child(InputTextBuilder("city_" + idx, &city.name).flex(2.0f));
-    row.add_child(InputNumberBuilder("lat_" + idx).bind_float(&city.latitude).flex(1.0f));
-    row.add_child(InputNumberBuilder("lon_" + idx).bind_float(&city.longitude).flex(1.0f));
-    row.add_child(InputNumberBuilder("elev_" + idx).bind_int(&city.elevation).flex(1.0f));
-    row.add_child(InputNumberBuilder("temp_" + idx).bind_float(&city.avg_temp).flex(1.0f));
-    row.add_child(build_climate_column("climate_" + idx, &city.climate_zone));
-
-    return row.build();
-}
-
-std::unique_ptr<Widget> CityDataPanelBuilder::build_climate_column(const std::string& base_id, int* binding) {
-    VLayoutBuilder climate(base_id);
-    climate.flex(1.0f).gap(2.0f);
-
-    const std::array<std::pair<const char*, int>, 3> options = {{
-        {"Temperate", 3},
-        {"Tropical", 1},
-        {"Arid", 2},
-    }};
-
-    int option_index = 0;
-    for (const auto& option : options) {
-        const std::string radio_id = base_id + "_" + std::to_string(option_index++);
-        climate.add_child(RadioButtonBuilder(radio_id, option.first, base_id, option.second, binding));
-    }
-
-    return climate.build();
+std::unique_ptr<Widget> CityDataPanelBuilder::build_city_table() {
+    // One table node for every row; only visible rows are drawn
+    TableBuilder<CityData> table("city_table", &data_.cities);
+    table.flex(1.0f)
+        .column("City", &CityData::name, 2.0f)
+        .column("Latitude", &CityData::latitude)
+        .column("Longitude", &CityData::longitude)
+        .column("Elevation (m)", &CityData::elevation)
+        .column("Avg Temp (°C)", &CityData::avg_temp)
+        .choice_column("Climate", &CityData::climate_zone, {{"Temperate", 3}, {"Tropical", 1}, {"Arid", 2}});
+
+    return table.build();
 }
 
 std::unique_ptr<Widget> CityDataPanelBuilder::build_button_row() {
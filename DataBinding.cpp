@@ -0,0 +1,142 @@
+#include "DataBinding.h"
+#include "Widget.h"
+#include <charconv>
+#include <cstring>
+
+// ============================================================================
+// CompiledBinding Implementation
+// ============================================================================
+
+CompiledBinding CompiledBinding::with_index(std::size_t index) const {
+    CompiledBinding binding = *this;
+    binding.index_ = index;
+    return binding;
+}
+
+BoundValue CompiledBinding::resolve(AppData& data) const {
+    if (!field_) {
+        return {};
+    }
+    void* address = field_->access(data, index_);
+    if (!address) {
+        return {};
+    }
+    return {field_->type, address};
+}
+
+// ============================================================================
+// BindingRegistry Implementation
+// ============================================================================
+
+const BindingRegistry& BindingRegistry::app_data() {
+    static const BindingRegistry registry = [] {
+        BindingRegistry r;
+        r.add_field("name", &AppData::name);
+        r.add_field("email", &AppData::email);
+        r.add_field("python", &AppData::python_selected);
+        r.add_field("go", &AppData::go_selected);
+        r.add_field("swift", &AppData::swift_selected);
+        r.add_field("rust", &AppData::rust_selected);
+        r.add_field("cpp", &AppData::cpp_selected);
+
+        r.add_collection_field("cities", &AppData::cities, "name", &CityData::name);
+        r.add_collection_field("cities", &AppData::cities, "latitude", &CityData::latitude);
+        r.add_collection_field("cities", &AppData::cities, "longitude", &CityData::longitude);
+        r.add_collection_field("cities", &AppData::cities, "elevation", &CityData::elevation);
+        r.add_collection_field("cities", &AppData::cities, "avg_temp", &CityData::avg_temp);
+        r.add_collection_field("cities", &AppData::cities, "population", &CityData::population);
+        r.add_collection_field("cities", &AppData::cities, "climate_zone", &CityData::climate_zone);
+        return r;
+    }();
+    return registry;
+}
+
+CompiledBinding BindingRegistry::compile(std::string_view path) const {
+    CompiledBinding binding;
+
+    // "cities[3].latitude" -> key "cities[].latitude", index 3. The key is
+    // composed on the stack; only paths longer than the buffer allocate.
+    std::string_view key = path;
+    char buffer[128];
+    std::string long_key;
+    std::size_t open = path.find('[');
+    if (open != std::string_view::npos) {
+        std::size_t close = path.find(']', open);
+        if (close == std::string_view::npos) {
+            return binding;
+        }
+        std::string_view digits = path.substr(open + 1, close - open - 1);
+        auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), binding.index_);
+        if (!digits.empty() && (ec != std::errc() || end != digits.data() + digits.size())) {
+            return binding;
+        }
+        std::string_view head = path.substr(0, open + 1);
+        std::string_view tail = path.substr(close);
+        if (head.size() + tail.size() <= sizeof(buffer)) {
+            std::memcpy(buffer, head.data(), head.size());
+            std::memcpy(buffer + head.size(), tail.data(), tail.size());
+            key = std::string_view(buffer, head.size() + tail.size());
+        } else {
+            long_key.reserve(head.size() + tail.size());
+            long_key.append(head);
+            long_key.append(tail);
+            key = long_key;
+        }
+    }
+
+    auto it = fields_.find(key);
+    if (it != fields_.end()) {
+        binding.field_ = &it->second;
+    }
+    return binding;
+}
+
+const BindingRegistry::CollectionSize* BindingRegistry::find_collection(std::string_view collection) const {
+    auto it = collections_.find(collection);
+    return it != collections_.end() ? &it->second : nullptr;
+}
+
+std::string BindingRegistry::expand_alias(std::string_view path, std::string_view alias, std::string_view source) {
+    if (alias.empty() || path.size() <= alias.size() || path.substr(0, alias.size()) != alias ||
+        path[alias.size()] != '.') {
+        return std::string(path);
+    }
+    
+    std::string expanded;
+    expanded.reserve(source.size() + 2 + path.size() - alias.size());
+    expanded.append(source);
+    expanded.append("[]");
+    expanded.append(path.substr(alias.size()));
+    return expanded;
+}
+
+// ============================================================================
+// Widget Binding
+// ============================================================================
+
+bool bind_widget(Widget& widget, const BoundValue& value) {
+    switch (widget.get_kind()) {
+    case WidgetKind::InputText:
+        static_cast<InputTextWidget&>(widget).bind_value(value.as<std::string>());
+        return true;
+    case WidgetKind::InputNumber: {
+        auto& number = static_cast<InputNumberWidget&>(widget);
+        if (float* float_value = value.as<float>()) {
+            number.bind_float_value(float_value);
+        } else if (int* int_value = value.as<int>()) {
+            number.bind_int_value(int_value);
+        } else {
+            return false;
+        }
+        return true;
+    }
+    case WidgetKind::Checkbox:
+        static_cast<CheckboxWidget&>(widget).bind_value(value.as<bool>());
+        return true;
+    case WidgetKind::RadioButton:
+        static_cast<RadioButtonWidget&>(widget).bind_selected(value.as<int>());
+        return true;
+    default:
+        return false;
+    }
+}
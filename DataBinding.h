@@ -0,0 +1,169 @@
+#pragma once
+#include "AppData.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+class Widget;
+
+/**
+ * @brief Value types a widget can be bound to
+ */
+enum class BindingType {
+    None,
+    String,
+    Bool,
+    Float,
+    Int,
+};
+
+template <typename T>
+constexpr BindingType binding_type_of() {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return BindingType::String;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return BindingType::Bool;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return BindingType::Float;
+    } else if constexpr (std::is_same_v<T, int>) {
+        return BindingType::Int;
+    } else {
+        static_assert(!sizeof(T), "Unsupported binding field type");
+    }
+}
+
+/**
+ * @brief Address of a bound field together with its type
+ */
+struct BoundValue {
+    BindingType type = BindingType::None;
+    void* address = nullptr;
+
+    template <typename T>
+    T* as() const {
+        return type == binding_type_of<T>() ? static_cast<T*>(address) : nullptr;
+    }
+};
+
+/**
+ * @brief Typed accessor for one registered field
+ *
+ * Indexed fields belong to a collection (e.g. `cities[].latitude`) and take
+ * the element index as their second argument.
+ */
+struct BindingField {
+    BindingType type = BindingType::None;
+    bool indexed = false;
+    std::function<void*(AppData&, std::size_t)> access;
+};
+
+/**
+ * @brief A bind path compiled down to a field accessor and an index
+ */
+class CompiledBinding {
+public:
+    bool valid() const { return field_ != nullptr; }
+    BindingType type() const { return field_ ? field_->type : BindingType::None; }
+    bool is_indexed() const { return field_ && field_->indexed; }
+    std::size_t index() const { return index_; }
+
+    CompiledBinding with_index(std::size_t index) const;
+    BoundValue resolve(AppData& data) const;
+
+private:
+    friend class BindingRegistry;
+
+    const BindingField* field_ = nullptr;
+    std::size_t index_ = 0;
+};
+
+/**
+ * @brief Describes the bindable fields of AppData once, as typed accessors
+ *
+ * Bind paths use member syntax: `name`, `python`, `cities[3].latitude`.
+ * Compiling a path normalizes the index away (`cities[].latitude`) and does a
+ * single hash lookup, so binding cost does not depend on how many fields are
+ * registered. Adding a field to the schema only needs a registration here;
+ * the XML parser resolves every path through the registry.
+ *
+ * The registry is specific to AppData: accessors take an AppData& and
+ * fields are registered as AppData member pointers. app_data() is the
+ * application's schema; a registry built with add_field and
+ * add_collection_field can describe other AppData fields, but binding to
+ * a different data type would need a registry of its own.
+ */
+class BindingRegistry {
+public:
+    static const BindingRegistry& app_data();
+
+    template <typename T>
+    void add_field(const std::string& name, T AppData::* member) {
+        fields_[name] = BindingField{binding_type_of<T>(), false,
+            [member](AppData& data, std::size_t) -> void* { return &(data.*member); }};
+    }
+
+    template <typename Element, typename T>
+    void add_collection_field(const std::string& collection, std::vector<Element> AppData::* source,
+                              const std::string& name, T Element::* member) {
+        fields_[collection + "[]." + name] = BindingField{binding_type_of<T>(), true,
+            [source, member](AppData& data, std::size_t index) -> void* {
+                auto& items = data.*source;
+                return index < items.size() ? &(items[index].*member) : nullptr;
+            }};
+        collections_[collection] = [source](const AppData& data) { return (data.*source).size(); };
+    }
+
+    CompiledBinding compile(std::string_view path) const;
+    BoundValue resolve(AppData& data, std::string_view path) const { return compile(path).resolve(data); }
+    
+    using CollectionSize = std::function<std::size_t(const AppData&)>;
+    
+    /**
+     * @brief Size accessor of a registered collection (e.g. `cities`), or nullptr
+     */
+    const CollectionSize* find_collection(std::string_view collection) const;
+    
+    /**
+     * @brief Rewrites a row-relative path to its collection form
+     * 
+     * With alias `city` and source `cities`, `city.latitude` becomes
+     * `cities[].latitude`; paths not starting with the alias are returned as-is.
+     */
+    static std::string expand_alias(std::string_view path, std::string_view alias, std::string_view source);
+
+private:
+    // Lets the maps be searched with a string_view, without building a key string
+    struct PathHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view path) const { return std::hash<std::string_view>()(path); }
+    };
+    
+    std::unordered_map<std::string, BindingField, PathHash, std::equal_to<>> fields_;
+    std::unordered_map<std::string, CollectionSize, PathHash, std::equal_to<>> collections_;
+};
+
+/**
+ * @brief Data an instantiated panel binds against
+ *
+ * Unset members fall back to the parser's app data and registry. With an
+ * alias, bind paths starting with it address one element of a collection:
+ * alias `city`, source `cities` and index 3 bind `city.name` to
+ * `cities[3].name`, so one blueprint can back a panel per element.
+ */
+struct BindingContext {
+    AppData* app_data = nullptr;
+    const BindingRegistry* registry = nullptr;
+    std::string alias;
+    std::string source;
+    std::size_t index = 0;
+};
+
+/**
+ * @brief Points a widget at a bound value, according to the widget type
+ * @return false if the widget cannot be bound to a value of this type
+ */
+bool bind_widget(Widget& widget, const BoundValue& value);
@@ -0,0 +1,230 @@
+#include "FileWatchService.h"
+#include "XmlParser.h"
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+#ifndef __linux__
+constexpr auto kPollInterval = std::chrono::milliseconds(250);
+#endif
+
+} // namespace
+
+// ============================================================================
+// FileWatchService Implementation
+// ============================================================================
+
+FileWatchService& FileWatchService::instance() {
+    static FileWatchService service;
+    return service;
+}
+
+FileWatchService::~FileWatchService() {
+    if (thread_.joinable()) {
+#ifdef __linux__
+        stopping_ = true;
+        std::uint64_t one = 1;
+        if (write(wake_fd_, &one, sizeof(one)) < 0) {
+            std::cerr << "Failed to wake file watch thread" << std::endl;
+        }
+#else
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+#endif
+        thread_.join();
+    }
+
+#ifdef __linux__
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+    }
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+    }
+#endif
+}
+
+bool FileWatchService::start() {
+#ifdef __linux__
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotify_fd_ < 0 || wake_fd_ < 0) {
+        std::cerr << "Failed to initialize inotify file watching" << std::endl;
+        return false;
+    }
+#endif
+    thread_ = std::thread([this]() { run(); });
+    return true;
+}
+
+void FileWatchService::subscribe(const std::string& file_path, XmlFileWatcher* watcher) {
+    if (!thread_.joinable() && !start()) {
+        return;
+    }
+
+    std::filesystem::path path = std::filesystem::absolute(file_path).lexically_normal();
+    std::string key = path.string();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = file_ids_.find(key);
+    FileId id;
+    if (it != file_ids_.end()) {
+        id = it->second;
+    } else {
+        id = static_cast<FileId>(files_.size());
+        WatchedFile file;
+        file.path = path;
+#ifndef __linux__
+        std::error_code ec;
+        file.last_write_time = std::filesystem::last_write_time(path, ec);
+#endif
+        files_.push_back(std::move(file));
+        file_ids_.emplace(key, id);
+        watch_directory(path.parent_path());
+    }
+    files_[id].watchers.push_back(watcher);
+}
+
+void FileWatchService::unsubscribe(XmlFileWatcher* watcher) {
+    for (auto& file : files_) {
+        file.watchers.erase(std::remove(file.watchers.begin(), file.watchers.end(), watcher), file.watchers.end());
+    }
+}
+
+void FileWatchService::watch_directory(const std::filesystem::path& directory) {
+#ifdef __linux__
+    // Adding an already watched directory returns its existing descriptor
+    int wd = inotify_add_watch(inotify_fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY);
+    if (wd < 0) {
+        std::cerr << "Failed to watch directory: " << directory.string() << std::endl;
+        return;
+    }
+    directories_[wd] = directory;
+#else
+    (void)directory;
+#endif
+}
+
+std::size_t FileWatchService::poll() {
+    std::size_t delivered = 0;
+    FileId id;
+
+    // Events were dropped, so treat every watched file as changed
+    if (overflowed_.load(std::memory_order_relaxed) && overflowed_.exchange(false)) {
+        while (changes_.pop(id)) {
+        }
+        for (auto& file : files_) {
+            for (auto* watcher : file.watchers) {
+                watcher->mark_changed();
+            }
+        }
+        return files_.size();
+    }
+
+    while (changes_.pop(id)) {
+        for (auto* watcher : files_[id].watchers) {
+            watcher->mark_changed();
+        }
+        ++delivered;
+    }
+    return delivered;
+}
+
+void FileWatchService::publish(FileId id) {
+    if (!changes_.push(id)) {
+        overflowed_ = true;
+    }
+}
+
+void FileWatchService::run() {
+    // Debounce deadline per file; a new event pushes the deadline back
+    std::unordered_map<FileId, Clock::time_point> pending;
+
+    while (!stopping_) {
+#ifdef __linux__
+        int timeout_ms = -1;
+        if (!pending.empty()) {
+            auto earliest = std::min_element(pending.begin(), pending.end(),
+                [](const auto& a, const auto& b) { return a.second < b.second; })->second;
+            auto wait = std::chrono::ceil<std::chrono::milliseconds>(earliest - Clock::now()).count();
+            timeout_ms = static_cast<int>(std::max<long long>(wait, 0));
+        }
+
+        pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+        int ready = ::poll(fds, 2, timeout_ms);
+        if (stopping_) {
+            return;
+        }
+
+        if (ready > 0 && (fds[0].revents & POLLIN)) {
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length;
+            while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+                auto deadline = Clock::now() + std::chrono::milliseconds(debounce_ms_.load());
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (char* cursor = buffer; cursor < buffer + length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(cursor);
+                    cursor += sizeof(inotify_event) + event->len;
+
+                    if (event->mask & IN_Q_OVERFLOW) {
+                        overflowed_ = true;
+                        continue;
+                    }
+                    if (event->len == 0) {
+                        continue;
+                    }
+                    auto directory = directories_.find(event->wd);
+                    if (directory == directories_.end()) {
+                        continue;
+                    }
+                    auto file = file_ids_.find((directory->second / event->name).string());
+                    if (file != file_ids_.end()) {
+                        pending[file->second] = deadline;
+                    }
+                }
+            }
+        }
+#else
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait_for(lock, kPollInterval, [this]() { return stopping_.load(); });
+            if (stopping_) {
+                return;
+            }
+
+            auto deadline = Clock::now() + std::chrono::milliseconds(debounce_ms_.load());
+            for (FileId id = 0; id < files_.size(); ++id) {
+                std::error_code ec;
+                auto write_time = std::filesystem::last_write_time(files_[id].path, ec);
+                if (!ec && write_time != files_[id].last_write_time) {
+                    files_[id].last_write_time = write_time;
+                    pending[id] = deadline;
+                }
+            }
+        }
+#endif
+
+        auto now = Clock::now();
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (it->second <= now) {
+                publish(it->first);
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
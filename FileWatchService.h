@@ -0,0 +1,84 @@
+#pragma once
+#include "SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class XmlFileWatcher;
+
+/**
+ * @brief Watches files for changes from a single background thread
+ *
+ * On Linux the thread blocks on one inotify descriptor that watches the
+ * parent directory of every subscribed file, so any number of files costs
+ * no syscalls on the UI thread. Other platforms fall back to polling the
+ * modification times on the background thread.
+ *
+ * Bursts of events for a file (editors often write, truncate and rename in
+ * one save) are debounced into a single change. Changes are handed to the UI
+ * thread through a lock-free queue that poll() drains once per frame.
+ * subscribe(), unsubscribe() and poll() must be called from the UI thread.
+ */
+class FileWatchService {
+public:
+    static FileWatchService& instance();
+    ~FileWatchService();
+
+    FileWatchService(const FileWatchService&) = delete;
+    FileWatchService& operator=(const FileWatchService&) = delete;
+
+    void subscribe(const std::string& file_path, XmlFileWatcher* watcher);
+    void unsubscribe(XmlFileWatcher* watcher);
+
+    /**
+     * @brief Delivers debounced changes to subscribed watchers
+     * @return Number of file changes delivered
+     */
+    std::size_t poll();
+
+    void set_debounce(std::chrono::milliseconds debounce) { debounce_ms_ = debounce.count(); }
+
+private:
+    using FileId = std::uint32_t;
+
+    struct WatchedFile {
+        std::filesystem::path path;
+        std::filesystem::file_time_type last_write_time{};  // polling backend only
+        std::vector<XmlFileWatcher*> watchers;               // UI thread only
+    };
+
+    FileWatchService() = default;
+
+    // Shared with the background thread, guarded by mutex_
+    std::mutex mutex_;
+    std::vector<WatchedFile> files_;
+    std::unordered_map<std::string, FileId> file_ids_;
+#ifdef __linux__
+    std::unordered_map<int, std::filesystem::path> directories_;  // inotify wd -> directory
+#endif
+
+    SpscQueue<FileId, 256> changes_;
+    std::atomic<bool> overflowed_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<long long> debounce_ms_{75};
+    std::thread thread_;
+
+#ifdef __linux__
+    int inotify_fd_ = -1;
+    int wake_fd_ = -1;
+#else
+    std::condition_variable wake_;
+#endif
+
+    bool start();
+    void watch_directory(const std::filesystem::path& directory);
+    void run();
+    void publish(FileId id);
+};
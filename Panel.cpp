@@ -1,16 +1,30 @@
 #include "Panel.h"
+#include "AllocationCounter.h"
+#include "TextMeasureCache.h"
+#include "ThreadPool.h"
 #include "imgui.h"
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <chrono>
 #include <iostream>
 
+namespace {
+
+// Content sizes closer than this lay out the same
+constexpr float kLayoutEpsilon = 0.5f;
+
+} // namespace
+
 // ============================================================================
 // Panel Implementation
 // ============================================================================
 
 Panel::Panel(const std::string& title, float width, float height)
-    : title_(title), width_(width), height_(height), base_width_(width), base_height_(height) {}
+    : title_(title), width_(width), height_(height), base_width_(width), base_height_(height),
+      widget_arena_(WidgetArena::create()), yoga_config_(YGConfigNew()) {
+    YGConfigSetPointScaleFactor(yoga_config_.get(), dpi_scale_);
+}
 
 void Panel::render() {
     if (!is_open_) return;
@@ -27,20 +41,42 @@ void Panel::render() {
         ImVec2 content_size = ImGui::GetContentRegionAvail();
         
         if (root_widget_) {
-            // Update layout only if the available size changed
-            constexpr float kEpsilon = 0.5f;
-            if (std::abs(last_layout_width_ - content_size.x) > kEpsilon ||
-                std::abs(last_layout_height_ - content_size.y) > kEpsilon) {
-                last_layout_width_ = content_size.x;
-                last_layout_height_ = content_size.y;
-                auto start = std::chrono::high_resolution_clock::now();
-                root_widget_->update_layout(content_size.x, content_size.y);
-                auto end = std::chrono::high_resolution_clock::now();
-                last_layout_duration_ms_ = std::chrono::duration<float, std::milli>(end - start).count();
+            // Measured sizes follow the font and style metrics, so a real
+            // change there restyles the tree. A DPI change alone leaves the
+            // logical metrics where they were and restyles nothing.
+            TextMeasureCache& text_cache = TextMeasureCache::instance();
+            text_cache.capture_metrics();
+            std::uint32_t metrics_generation = text_cache.get_metrics_generation();
+            if (metrics_generation != metrics_generation_) {
+                metrics_generation_ = metrics_generation;
+                ++style_generation_;
+            }
+            // A layout that had to estimate text re-measures just the measured leaves
+            if (remeasure_pending_) {
+                remeasure_pending_ = false;
+                remeasure_text();
+            }
+            
+            // Stamp or drop data-driven children first, so they are laid out and drawn this frame
+            sync_dynamic_children();
+            
+            // Update layout only if the available size, the scale or the tree changed
+            if (std::abs(last_layout_width_ - content_size.x) > kLayoutEpsilon ||
+                std::abs(last_layout_height_ - content_size.y) > kLayoutEpsilon ||
+                style_generation_ != synced_style_generation_ ||
+                YGNodeIsDirty(root_widget_->get_yoga_node())) {
+                layout_root(content_size.x, content_size.y);
             }
             
             // Render the widget tree
-            root_widget_->render();
+            if (storage_ == Storage::DataOriented) {
+                sync_widget_store();
+            }
+            if (positioned_) {
+                render_positioned();
+            } else {
+                render_tree();
+            }
         }
     }
     ImGui::End();
@@ -48,14 +84,247 @@ void Panel::render() {
     on_after_render();
 }
 
+void Panel::render_positioned() {
+    Widget::RenderRegion region;
+    region.origin = ImGui::GetCursorScreenPos();
+    region.clip_min = ImGui::GetWindowDrawList()->GetClipRectMin();
+    region.clip_max = ImGui::GetWindowDrawList()->GetClipRectMax();
+    
+    const Widget::LayoutBox& root = root_widget_->get_layout();
+    Widget::set_render_region(&region);
+    ImGui::SetCursorScreenPos(ImVec2(region.origin.x + root.left, region.origin.y + root.top));
+    render_tree();
+    Widget::set_render_region(nullptr);
+    
+    // Claim the whole laid-out area so the window scrolls over culled widgets too
+    ImGui::SetCursorScreenPos(region.origin);
+    ImGui::Dummy(ImVec2(root.left + root.width, root.top + root.height));
+}
+
+void Panel::render_tree() {
+    if (storage_ == Storage::DataOriented) {
+        widget_store_.render();
+    } else {
+        root_widget_->render();
+    }
+}
+
+void Panel::sync_widget_store() {
+    // Any added, removed, renamed or edited widget moves the index version
+    if (widget_store_.get_root() != root_widget_.get() || store_version_ != widget_index_.get_version()) {
+        widget_store_.build(*root_widget_);
+        store_version_ = widget_index_.get_version();
+        store_layout_pass_ = layout_pass_count_;
+    } else if (store_layout_pass_ != layout_pass_count_) {
+        widget_store_.refresh_layout();
+        store_layout_pass_ = layout_pass_count_;
+    }
+}
+
+void Panel::sync_dynamic_children() {
+    // Joining or leaving the tree moves the index version, so the list is only rebuilt after a change
+    if (dynamic_containers_version_ != widget_index_.get_version()) {
+        collect_dynamic_containers();
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (ContainerWidget* container : dynamic_containers_) {
+            if (container->sync_children()) {
+                changed = true;
+                break;
+            }
+        }
+        if (changed) {
+            // Dropped rows may have held later entries; start over on the new tree
+            collect_dynamic_containers();
+        }
+    }
+}
+
+void Panel::collect_dynamic_containers() {
+    dynamic_containers_.clear();
+    if (root_widget_) {
+        walk_widgets(*root_widget_, [this](Widget& widget) {
+            if (widget.get_kind() == WidgetKind::Repeat) {
+                dynamic_containers_.push_back(static_cast<ContainerWidget*>(&widget));
+            }
+            return true;
+        });
+    }
+    dynamic_containers_version_ = widget_index_.get_version();
+}
+
+void Panel::remeasure_text() {
+    walk_widgets(*root_widget_, [](Widget& widget) {
+        widget.mark_measure_dirty();
+        return true;
+    });
+}
+
+void Panel::set_storage(Storage storage) {
+    storage_ = storage;
+    if (storage_ == Storage::Objects) {
+        widget_store_.clear();
+    }
+}
+
 void Panel::update_layout() {
     if (root_widget_) {
-        auto start = std::chrono::high_resolution_clock::now();
-        root_widget_->update_layout(width_, height_);
-        auto end = std::chrono::high_resolution_clock::now();
-        last_layout_duration_ms_ = std::chrono::duration<float, std::milli>(end - start).count();
-        last_layout_width_ = width_;
-        last_layout_height_ = height_;
+        layout_root(width_, height_);
+    }
+}
+
+void Panel::prepare_layout(float content_width, float content_height) {
+    if (root_widget_) {
+        layout_root(content_width, content_height);
+    }
+}
+
+void Panel::layout_root(float width, float height) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::size_t estimates = TextMeasureCache::thread_estimate_count();
+    root_widget_->sync_styles(style_generation_);
+    synced_style_generation_ = style_generation_;
+    
+    // Recorded frames describe the tree as it was; any change since dirties the root
+    if (YGNodeIsDirty(root_widget_->get_yoga_node())) {
+        invalidate_layout_frames();
+    }
+    
+    LayoutFrame* frame = find_layout_frame(width, height);
+    if (frame && restore_layout_frame(*frame)) {
+        frame->last_used = ++layout_frame_clock_;
+    } else {
+        if (frame) {
+            frame->valid = false;
+        }
+        // Yoga works in logical units; read_back_layout() scales back to pixels
+        root_widget_->update_layout(width / dpi_scale_, height / dpi_scale_);
+        LayoutFrame& recorded = claim_layout_frame();
+        read_back_layout(&recorded.boxes);
+        if (TextMeasureCache::thread_estimate_count() != estimates) {
+            // Estimated text gets measured again; don't keep a frame built on it
+            remeasure_pending_ = true;
+        } else {
+            recorded.dpi_scale = dpi_scale_;
+            recorded.width = width;
+            recorded.height = height;
+            recorded.last_used = ++layout_frame_clock_;
+            recorded.valid = true;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    last_layout_duration_ms_ = std::chrono::duration<float, std::milli>(end - start).count();
+    last_layout_width_ = width;
+    last_layout_height_ = height;
+    ++layout_pass_count_;
+}
+
+void Panel::read_back_layout(std::vector<Widget::LayoutBox>* record) {
+    // One flat pre-order walk; parent offsets accumulate into panel-relative positions
+    last_layout_stats_ = {};
+    if (record) {
+        record->clear();
+    }
+    readback_stack_.clear();
+    readback_stack_.push_back({root_widget_.get(), 0.0f, 0.0f});
+    
+    while (!readback_stack_.empty()) {
+        PendingReadback item = readback_stack_.back();
+        readback_stack_.pop_back();
+        
+        Widget* widget = item.widget;
+        YGNodeRef node = widget->get_yoga_node();
+        if (!node) {
+            continue;
+        }
+        
+        if (YGNodeGetHasNewLayout(node)) {
+            YGNodeSetHasNewLayout(node, false);
+            ++last_layout_stats_.laid_out;
+        } else {
+            ++last_layout_stats_.reused;
+        }
+        
+        Widget::LayoutBox& box = widget->layout_;
+        box.left = item.left + YGNodeLayoutGetLeft(node) * dpi_scale_;
+        box.top = item.top + YGNodeLayoutGetTop(node) * dpi_scale_;
+        box.width = YGNodeLayoutGetWidth(node) * dpi_scale_;
+        box.height = YGNodeLayoutGetHeight(node) * dpi_scale_;
+        if (record) {
+            record->push_back(box);
+        }
+        
+        if (auto* container = widget_cast<ContainerWidget>(widget)) {
+            for (const auto& child : container->get_children()) {
+                readback_stack_.push_back({child.get(), box.left, box.top});
+            }
+        }
+    }
+}
+
+Panel::LayoutFrame* Panel::find_layout_frame(float width, float height) {
+    for (auto& frame : layout_frames_) {
+        if (frame.valid && frame.dpi_scale == dpi_scale_ && std::abs(frame.width - width) <= kLayoutEpsilon &&
+            std::abs(frame.height - height) <= kLayoutEpsilon) {
+            return &frame;
+        }
+    }
+    return nullptr;
+}
+
+Panel::LayoutFrame& Panel::claim_layout_frame() {
+    // An invalid slot if there is one, else the least recently used; box storage is reused
+    LayoutFrame* claimed = &layout_frames_.front();
+    for (auto& frame : layout_frames_) {
+        if (!frame.valid) {
+            claimed = &frame;
+            break;
+        }
+        if (frame.last_used < claimed->last_used) {
+            claimed = &frame;
+        }
+    }
+    claimed->valid = false;
+    return *claimed;
+}
+
+bool Panel::restore_layout_frame(const LayoutFrame& frame) {
+    // Same walk as read_back_layout(), so boxes line up with the widgets they came from
+    std::size_t index = 0;
+    readback_stack_.clear();
+    readback_stack_.push_back({root_widget_.get(), 0.0f, 0.0f});
+    
+    while (!readback_stack_.empty()) {
+        Widget* widget = readback_stack_.back().widget;
+        readback_stack_.pop_back();
+        if (!widget->get_yoga_node()) {
+            continue;
+        }
+        if (index == frame.boxes.size()) {
+            return false;
+        }
+        widget->layout_ = frame.boxes[index++];
+        
+        if (auto* container = widget_cast<ContainerWidget>(widget)) {
+            for (const auto& child : container->get_children()) {
+                readback_stack_.push_back({child.get(), 0.0f, 0.0f});
+            }
+        }
+    }
+    if (index != frame.boxes.size()) {
+        return false;
+    }
+    
+    last_layout_stats_ = {};
+    last_layout_stats_.restored = index;
+    return true;
+}
+
+void Panel::invalidate_layout_frames() {
+    for (auto& frame : layout_frames_) {
+        frame.valid = false;
     }
 }
 
@@ -65,10 +334,17 @@ void Panel::fit_to_content() {
     }
 
     // Let Yoga compute the natural size for the layout.
+    std::size_t estimates = TextMeasureCache::thread_estimate_count();
+    root_widget_->sync_styles(style_generation_);
+    synced_style_generation_ = style_generation_;
     root_widget_->update_layout(YGUndefined, YGUndefined);
+    read_back_layout();
+    if (TextMeasureCache::thread_estimate_count() != estimates) {
+        remeasure_pending_ = true;
+    }
 
-    float content_width = YGNodeLayoutGetWidth(root_widget_->get_yoga_node());
-    float content_height = YGNodeLayoutGetHeight(root_widget_->get_yoga_node());
+    float content_width = root_widget_->get_layout().width;
+    float content_height = root_widget_->get_layout().height;
 
     if (content_width <= 0.0f) {
         content_width = width_;
@@ -110,53 +386,52 @@ void Panel::set_dpi_scale(float scale) {
     if (scale <= 0.0f) {
         return;
     }
+    // Styles stay logical: Yoga rounds to the new pixel grid and readback
+    // scales, so the next render's single layout pass is all a change costs
     dpi_scale_ = scale;
+    YGConfigSetPointScaleFactor(yoga_config_.get(), scale);
     width_ = base_width_ * dpi_scale_;
     height_ = base_height_ * dpi_scale_;
-    last_layout_width_ = -1.0f;
-    last_layout_height_ = -1.0f;
+    invalidate_layout();
     size_dirty_ = true;
-    update_layout();
+}
+
+void Panel::carry_state_from(const Panel& previous) {
+    is_open_ = previous.is_open_;
+    positioned_ = previous.positioned_;
+    set_storage(previous.storage_);
+    if (dpi_scale_ != previous.dpi_scale_) {
+        set_dpi_scale(previous.dpi_scale_);
+    }
+    // Same size in the XML: leave the window at the size ImGui has for it
+    if (base_width_ == previous.base_width_ && base_height_ == previous.base_height_ && !previous.size_dirty_) {
+        width_ = previous.width_;
+        height_ = previous.height_;
+        size_dirty_ = false;
+    }
 }
 
 void Panel::set_root_widget(std::unique_ptr<Widget> root) {
     root_widget_ = std::move(root);
+    invalidate_layout_frames();
+    if (root_widget_) {
+        root_widget_->set_yoga_config(yoga_config_.get());
+        root_widget_->set_widget_index(&widget_index_);
+    }
     last_layout_width_ = -1.0f;
     last_layout_height_ = -1.0f;
     update_layout();
 }
 
-Widget* Panel::find_widget(const std::string& id) {
-    if (!root_widget_) return nullptr;
-    
-    if (root_widget_->get_id() == id) {
-        return root_widget_.get();
-    }
-    
-    return find_widget_recursive(root_widget_.get(), id);
+std::unique_ptr<Widget> Panel::release_root_widget() {
+    // The store and the container list point into the tree they were built from
+    widget_store_.clear();
+    dynamic_containers_.clear();
+    return std::move(root_widget_);
 }
 
-Widget* Panel::find_widget_recursive(Widget* widget, const std::string& id) {
-    if (!widget) return nullptr;
-    
-    // Check if this widget is a container
-    ContainerWidget* container = dynamic_cast<ContainerWidget*>(widget);
-    if (container) {
-        // Search through children
-        for (const auto& child : container->get_children()) {
-            if (child->get_id() == id) {
-                return child.get();
-            }
-            
-            // Recursively search in child containers
-            Widget* found = find_widget_recursive(child.get(), id);
-            if (found) {
-                return found;
-            }
-        }
-    }
-    
-    return nullptr;
+Widget* Panel::find_widget(const std::string& id) const {
+    return widget_index_.find(id);
 }
 
 // ============================================================================
@@ -165,11 +440,13 @@ Widget* Panel::find_widget_recursive(Widget* widget, const std::string& id) {
 
 void PanelManager::add_panel(const std::string& name, std::unique_ptr<Panel> panel) {
     if (panel) {
+        drop_deferred_panel(name);
         panels_[name] = std::move(panel);
     }
 }
 
 void PanelManager::remove_panel(const std::string& name) {
+    drop_deferred_panel(name);
     panels_.erase(name);
 }
 
@@ -178,12 +455,198 @@ Panel* PanelManager::get_panel(const std::string& name) {
     return (it != panels_.end()) ? it->second.get() : nullptr;
 }
 
+std::unique_ptr<Panel> PanelManager::replace_panel(const std::string& name, std::unique_ptr<Panel> panel) {
+    if (!panel) {
+        return nullptr;
+    }
+    
+    drop_deferred_panel(name);
+    std::unique_ptr<Panel>& slot = panels_[name];
+    if (slot) {
+        panel->carry_state_from(*slot);
+    }
+    std::swap(slot, panel);
+    return panel;
+}
+
+void PanelManager::add_deferred_panel(const std::string& name, PanelFactory factory, bool prefetch) {
+    if (!factory) {
+        return;
+    }
+    drop_deferred_panel(name);
+    panels_.erase(name);
+    
+    DeferredPanel& deferred = deferred_panels_[name];
+    deferred.factory = std::move(factory);
+    deferred.prefetch = prefetch;
+    if (prefetch) {
+        start_prefetch(deferred);
+    }
+}
+
+void PanelManager::refresh_deferred_panel(const std::string& name) {
+    auto it = deferred_panels_.find(name);
+    if (it == deferred_panels_.end() || !it->second.build.valid()) {
+        return;
+    }
+    // The stale build is retired once it finishes, like a superseded reload
+    superseded_swaps_.push_back(std::move(it->second.build));
+    start_prefetch(it->second);
+}
+
+void PanelManager::start_prefetch(DeferredPanel& deferred) {
+    deferred.build = ThreadPool::instance().submit([factory = deferred.factory]() {
+        auto panel = factory();
+        if (panel) {
+            panel->set_open(false);
+        }
+        return panel;
+    });
+}
+
+void PanelManager::drop_deferred_panel(const std::string& name) {
+    auto it = deferred_panels_.find(name);
+    if (it == deferred_panels_.end()) {
+        return;
+    }
+    if (it->second.build.valid()) {
+        superseded_swaps_.push_back(std::move(it->second.build));
+    }
+    deferred_panels_.erase(it);
+}
+
+Panel* PanelManager::get_or_build_panel(const std::string& name) {
+    if (Panel* panel = get_panel(name)) {
+        return panel;
+    }
+    auto it = deferred_panels_.find(name);
+    if (it == deferred_panels_.end()) {
+        return nullptr;
+    }
+    
+    // A prefetched panel may still be building; otherwise build it here
+    DeferredPanel deferred = std::move(it->second);
+    deferred_panels_.erase(it);
+    std::unique_ptr<Panel> panel = deferred.build.valid() ? deferred.build.get() : deferred.factory();
+    if (!panel) {
+        std::cerr << "Deferred panel '" << name << "' failed to build" << std::endl;
+        return nullptr;
+    }
+    
+    // Built closed, so the caller's show or toggle decides; at the scale the others use
+    panel->set_open(false);
+    if (dpi_scale_ != 1.0f) {
+        panel->set_dpi_scale(dpi_scale_);
+    }
+    Panel* built = panel.get();
+    panels_[name] = std::move(panel);
+    return built;
+}
+
+void PanelManager::swap_panel_when_ready(const std::string& name, std::future<std::unique_ptr<Panel>> panel) {
+    auto it = std::find_if(pending_swaps_.begin(), pending_swaps_.end(),
+        [&name](const auto& pending) { return pending.first == name; });
+    if (it != pending_swaps_.end()) {
+        // Keep the superseded build until it finishes, then retire it unused
+        superseded_swaps_.push_back(std::move(it->second));
+        it->second = std::move(panel);
+    } else {
+        pending_swaps_.emplace_back(name, std::move(panel));
+    }
+}
+
+std::size_t PanelManager::apply_pending_swaps() {
+    auto is_ready = [](const std::future<std::unique_ptr<Panel>>& future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+    auto retire = [](std::unique_ptr<Panel> panel) {
+        if (panel) {
+            ThreadPool::instance().submit([panel = std::move(panel)]() mutable { panel.reset(); });
+        }
+    };
+    
+    for (auto it = superseded_swaps_.begin(); it != superseded_swaps_.end();) {
+        if (is_ready(*it)) {
+            retire(it->get());
+            it = superseded_swaps_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    
+    std::size_t swapped = 0;
+    for (auto it = pending_swaps_.begin(); it != pending_swaps_.end();) {
+        if (!is_ready(it->second)) {
+            ++it;
+            continue;
+        }
+        
+        auto panel = it->second.get();
+        if (panel) {
+            // Already built and laid out; the old panel goes away on the pool
+            retire(replace_panel(it->first, std::move(panel)));
+            ++swapped;
+        }
+        it = pending_swaps_.erase(it);
+    }
+    return swapped;
+}
+
+void PanelManager::wait_pending_swaps() {
+    for (auto& pending : pending_swaps_) {
+        pending.second.wait();
+    }
+    for (auto& superseded : superseded_swaps_) {
+        superseded.wait();
+    }
+    for (auto& [name, deferred] : deferred_panels_) {
+        if (deferred.build.valid()) {
+            deferred.build.wait();
+        }
+    }
+    pending_swaps_.clear();
+    superseded_swaps_.clear();
+}
+
 void PanelManager::render_all() {
+    std::size_t allocations_before = allocation_counter::thread_allocations();
+    auto signature_before = allocation_counter::kEnabled ? frame_signature() : std::pair<std::uint64_t, std::size_t>();
+    
     for (auto& [name, panel] : panels_) {
         if (panel) {
             panel->render();
         }
     }
+    
+    if constexpr (allocation_counter::kEnabled) {
+        check_render_allocations(allocation_counter::thread_allocations() - allocations_before, signature_before);
+    }
+}
+
+std::pair<std::uint64_t, std::size_t> PanelManager::frame_signature() const {
+    std::pair<std::uint64_t, std::size_t> signature;
+    for (const auto& [name, panel] : panels_) {
+        if (panel) {
+            signature.first += panel->get_layout_pass_count();
+            signature.second += panel->is_open() ? 1 : 0;
+        }
+    }
+    return signature;
+}
+
+void PanelManager::check_render_allocations(std::size_t allocations,
+                                            std::pair<std::uint64_t, std::size_t> signature_before) {
+    last_render_allocations_ = allocations;
+    
+    // Relayouts, panels opening or closing and edits (a bound string growing)
+    // may allocate; a frame counts as steady when neither it nor the one before
+    // had any of them
+    bool steady = frame_signature() == signature_before && !ImGui::IsAnyItemActive() && !ImGui::IsAnyMouseDown();
+    if (steady && previous_frame_steady_ && allocations != 0) {
+        std::cerr << "render_all made " << allocations << " heap allocations in a steady-state frame" << std::endl;
+        assert(allocations == 0 && "steady-state rendering must not allocate");
+    }
+    previous_frame_steady_ = steady;
 }
 
 void PanelManager::update_all_layouts() {
@@ -195,7 +658,7 @@ void PanelManager::update_all_layouts() {
 }
 
 void PanelManager::show_panel(const std::string& name) {
-    Panel* panel = get_panel(name);
+    Panel* panel = get_or_build_panel(name);
     if (panel) {
         panel->show();
     }
@@ -209,7 +672,7 @@ void PanelManager::hide_panel(const std::string& name) {
 }
 
 void PanelManager::toggle_panel(const std::string& name) {
-    Panel* panel = get_panel(name);
+    Panel* panel = get_or_build_panel(name);
     if (panel) {
         panel->toggle();
     }
@@ -219,6 +682,7 @@ void PanelManager::set_all_dpi_scale(float scale) {
     if (scale <= 0.0f) {
         return;
     }
+    dpi_scale_ = scale;
     for (auto& [name, panel] : panels_) {
         if (panel) {
             panel->set_dpi_scale(scale);
@@ -244,3 +708,15 @@ std::pair<float, float> PanelManager::get_layout_durations() {
     peak_layout_duration_ms_ = std::max(peak_layout_duration_ms_, current_max);
     return {current_max, peak_layout_duration_ms_};
 }
+
+Panel::LayoutStats PanelManager::get_layout_stats() const {
+    Panel::LayoutStats total;
+    for (const auto& [name, panel] : panels_) {
+        if (panel) {
+            total.laid_out += panel->get_last_layout_stats().laid_out;
+            total.reused += panel->get_last_layout_stats().reused;
+            total.restored += panel->get_last_layout_stats().restored;
+        }
+    }
+    return total;
+}
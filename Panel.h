@@ -1,9 +1,17 @@
 #pragma once
 #include "Widget.h"
+#include "WidgetArena.h"
+#include "WidgetIndex.h"
+#include "WidgetStore.h"
+#include <array>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <map>
+#include <functional>
+#include <future>
 #include <utility>
+#include <vector>
 
 /**
  * @brief Represents a complete UI panel that can be rendered as a window
@@ -14,6 +22,20 @@
  */
 class Panel {
 public:
+    /**
+     * @brief Node counts of the last layout pass
+     * 
+     * `laid_out` nodes got a new layout from Yoga; `reused` nodes were
+     * served from Yoga's layout cache. `restored` nodes took a box recorded
+     * by an earlier pass at the same DPI scale and content size, without
+     * Yoga running at all.
+     */
+    struct LayoutStats {
+        std::size_t laid_out = 0;
+        std::size_t reused = 0;
+        std::size_t restored = 0;
+    };
+    
     /**
      * @brief Constructor
      * @param title The title of the panel window
@@ -32,6 +54,15 @@ public:
     const std::string& get_title() const { return title_; }
     void set_title(const std::string& title) { title_ = title; }
     
+    /**
+     * @brief Takes over the view state of the panel this one replaces
+     * 
+     * Open state, positioned mode, storage backend and DPI scale. If the
+     * logical size is unchanged, the window keeps its current size instead
+     * of being reset to the size in the XML.
+     */
+    void carry_state_from(const Panel& previous);
+    
     void fit_to_content();
     
     float get_width() const { return width_; }
@@ -46,21 +77,86 @@ public:
     void hide() { is_open_ = false; }
     void toggle() { is_open_ = !is_open_; }
 
+    /**
+     * @brief Places widgets at their Yoga positions instead of ImGui flow
+     * 
+     * Subtrees outside the window's clip rect are skipped, so frame cost
+     * follows what is visible. Leaves are placed by their layout boxes,
+     * which Yoga sizes from their text through TextMeasureCache.
+     */
+    bool is_positioned() const { return positioned_; }
+    void set_positioned(bool positioned) { positioned_ = positioned; }
+    
+    /**
+     * @brief Scale from the panel's logical units to pixels
+     * 
+     * Widget styles, explicit sizes and measured text are logical; the
+     * panel's Yoga config rounds layouts to this scale's pixel grid and
+     * read-back boxes are scaled to pixels. Keep it equal to the scale the
+     * ImGui font and style were scaled by.
+     */
     float get_dpi_scale() const { return dpi_scale_; }
     void set_dpi_scale(float scale);
+    
+    /**
+     * @brief How the tree is walked when rendering
+     * 
+     * `Objects` calls each widget's virtual render() through the child
+     * pointers. `DataOriented` draws from a WidgetStore: flat per-field
+     * arrays copied from the tree, rebuilt only when a widget is added,
+     * removed or changed. Widgets, lookups and layout are the same either
+     * way; only the render walk differs.
+     */
+    enum class Storage : std::uint8_t { Objects, DataOriented };
+    Storage get_storage() const { return storage_; }
+    void set_storage(Storage storage);
 
     float get_last_layout_duration_ms() const { return last_layout_duration_ms_; }
+    float get_last_layout_width() const { return last_layout_width_; }
+    float get_last_layout_height() const { return last_layout_height_; }
+    const LayoutStats& get_last_layout_stats() const { return last_layout_stats_; }
+    std::uint64_t get_layout_pass_count() const { return layout_pass_count_; }
+    
+    /**
+     * @brief Lays out the widget tree for a known content size ahead of render
+     * 
+     * Lets a panel built on a worker thread arrive with its layout done, so
+     * the first render skips layout if the window content size matches.
+     */
+    void prepare_layout(float content_width, float content_height);
+    
+    /**
+     * @brief Arena the panel's widgets are built in
+     * 
+     * Builders open a WidgetArena::Scope on it while creating the tree, so
+     * the widgets are packed together and the panel's teardown frees their
+     * memory in a few blocks. Widgets created outside a scope use the heap.
+     */
+    WidgetArena* get_widget_arena() const { return widget_arena_.get(); }
     
     // Widget management
     void set_root_widget(std::unique_ptr<Widget> root);
     Widget* get_root_widget() const { return root_widget_.get(); }
+    std::unique_ptr<Widget> release_root_widget();
+    
+    // Forces a layout pass on the next render; Yoga only recomputes dirty subtrees
+    void invalidate_layout() { last_layout_width_ = -1.0f; last_layout_height_ = -1.0f; }
     
-    // Utility functions
-    Widget* find_widget(const std::string& id);
+    // Bumped on font and style metric changes; widgets restyle when it moves
+    std::uint32_t get_style_generation() const { return style_generation_; }
+    
+    /**
+     * @brief Widget with the given id, or nullptr
+     * 
+     * One hash lookup in the panel's WidgetIndex, which follows the tree as
+     * children are added, removed or renamed; cheap enough to call per frame.
+     */
+    Widget* find_widget(const std::string& id) const;
     
+    // Typed lookup; a kind tag compare, no RTTI
     template<typename T>
-    T* find_widget_as(const std::string& id) {
-        return dynamic_cast<T*>(find_widget(id));
+    T* find_widget_as(const std::string& id) const {
+        return widget_cast<T>(find_widget(id));
     }
     
 protected:
@@ -74,15 +170,84 @@ private:
     float base_width_;
     float base_height_;
     float dpi_scale_ = 1.0f;
+    
+    // Reference counted: widgets keep it alive, so member order does not matter
+    WidgetArena::Handle widget_arena_;
+    
+    struct YogaConfigDeleter {
+        void operator()(YGConfigRef config) const { YGConfigFree(config); }
+    };
+    // Shared by every node of the tree; declared before root_widget_ so it outlives them
+    std::unique_ptr<YGConfig, YogaConfigDeleter> yoga_config_;
+    // Widgets unregister on destruction, so this also has to outlive the tree
+    WidgetIndex widget_index_;
     float last_layout_width_ = -1.0f;
     float last_layout_height_ = -1.0f;
     float last_layout_duration_ms_ = 0.0f;
+    LayoutStats last_layout_stats_;
+    std::uint64_t layout_pass_count_ = 0;
+    
+    /**
+     * @brief Boxes of one layout pass, in read_back_layout() order
+     * 
+     * The last few passes are kept per DPI scale and content size, so
+     * toggling back to a scale or size seen before restores the boxes
+     * instead of running Yoga. Any change to the tree dirties the Yoga
+     * root, which invalidates every frame.
+     */
+    struct LayoutFrame {
+        float dpi_scale = 0.0f;
+        float width = 0.0f;
+        float height = 0.0f;
+        std::uint64_t last_used = 0;
+        bool valid = false;
+        std::vector<Widget::LayoutBox> boxes;
+    };
+    static constexpr std::size_t kMaxLayoutFrames = 4;
+    std::array<LayoutFrame, kMaxLayoutFrames> layout_frames_;
+    std::uint64_t layout_frame_clock_ = 0;
+    std::uint32_t metrics_generation_ = 0;  // TextMeasureCache metrics the tree was styled for
+    std::uint32_t style_generation_ = 1;
+    std::uint32_t synced_style_generation_ = 0;
     bool size_dirty_ = true;
     bool is_open_ = true;
+    bool positioned_ = false;
+    bool remeasure_pending_ = false;  // the last layout estimated text it could not measure
+    Storage storage_ = Storage::Objects;
     std::unique_ptr<Widget> root_widget_;
     
-    // Helper function for recursive widget search
-    Widget* find_widget_recursive(Widget* widget, const std::string& id);
+    // Data-oriented backend, and the index version and layout pass it was copied at
+    WidgetStore widget_store_;
+    std::uint64_t store_version_ = 0;
+    std::uint64_t store_layout_pass_ = 0;
+    
+    // Containers whose children follow bound data, and the index version they were collected at
+    std::vector<ContainerWidget*> dynamic_containers_;
+    std::uint64_t dynamic_containers_version_ = 0;
+    
+    // Lets each such container add or drop children before the layout check
+    void sync_dynamic_children();
+    void collect_dynamic_containers();
+    // Marks every measured leaf dirty, for text that was estimated instead of measured
+    void remeasure_text();
+    // Syncs dirty widget styles, then lays out the tree for the given size
+    void layout_root(float width, float height);
+    // Reads Yoga's results into the widgets, appending each box to `record` if given
+    void read_back_layout(std::vector<Widget::LayoutBox>* record = nullptr);
+    LayoutFrame* find_layout_frame(float width, float height);
+    LayoutFrame& claim_layout_frame();
+    bool restore_layout_frame(const LayoutFrame& frame);
+    void invalidate_layout_frames();
+    void sync_widget_store();
+    void render_tree();
+    void render_positioned();
+    
+    struct PendingReadback {
+        Widget* widget;
+        float left;
+        float top;
+    };
+    std::vector<PendingReadback> readback_stack_;
 };
 
 /**
@@ -98,13 +263,66 @@ public:
         return instance;
     }
     
+    using PanelFactory = std::function<std::unique_ptr<Panel>()>;
+    
     // Panel management
     void add_panel(const std::string& name, std::unique_ptr<Panel> panel);
     void remove_panel(const std::string& name);
+    // Built panels only; nullptr for a deferred panel that was never opened
     Panel* get_panel(const std::string& name);
     
+    /**
+     * @brief Registers a panel that is built the first time it is opened
+     * 
+     * show_panel() and toggle_panel() call `factory` when they first open
+     * `name`. Until then the panel costs only the factory: nothing is
+     * parsed, laid out or held in memory. With `prefetch`, the panel is
+     * built on the thread pool right away and opening it only waits for a
+     * build still in progress; the factory must then be safe to call on a
+     * worker. Adding a built panel under the same name drops the
+     * registration.
+     */
+    void add_deferred_panel(const std::string& name, PanelFactory factory, bool prefetch = false);
+    bool is_panel_deferred(const std::string& name) const { return deferred_panels_.count(name) != 0; }
+    
+    // Drops a prefetched build after the panel's source changed, and prefetches again if registered to
+    void refresh_deferred_panel(const std::string& name);
+    
+    /**
+     * @brief Swaps in a new panel, carrying over the view state of the one it replaces
+     * @return The replaced panel (nullptr if there was none)
+     */
+    std::unique_ptr<Panel> replace_panel(const std::string& name, std::unique_ptr<Panel> panel);
+    
+    // Background reloads: the panel is built by the future's producer thread and
+    // applied by apply_pending_swaps() once ready. A newer request for the
+    // same name supersedes an older one still in flight.
+    void swap_panel_when_ready(const std::string& name, std::future<std::unique_ptr<Panel>> panel);
+    
+    /**
+     * @brief Applies finished background builds; call at the start of a frame
+     * 
+     * Each build replaces its panel whole through replace_panel(), so the
+     * UI thread does a pointer swap whatever the panel size: parsing,
+     * building and layout already ran on the worker, and the old panel is
+     * destroyed on the thread pool. The panel's view state carries over
+     * (see Panel::carry_state_from), and ImGui keeps its own state under the
+     * same window title and widget ids. Widgets hold no other UI state, as
+     * values live in the bound AppData. The trade-off is that Panel and
+     * Widget pointers taken before the swap are invalidated; callers that
+     * hold them should reload synchronously with XmlParser::reload_panel,
+     * which reconciles in place.
+     * @return Number of panels updated
+     */
+    std::size_t apply_pending_swaps();
+    void wait_pending_swaps();
+    
     // Rendering
     void render_all();
+    
+    // Allocations made by the last render_all(); always zero unless built
+    // with IMGUI_XML_COUNT_ALLOCATIONS (see AllocationCounter.h)
+    std::size_t get_last_render_allocations() const { return last_render_allocations_; }
     void update_all_layouts();
     
     // Utility
@@ -113,12 +331,34 @@ public:
     void toggle_panel(const std::string& name);
     void set_all_dpi_scale(float scale);
     std::pair<float, float> get_layout_durations();
+    Panel::LayoutStats get_layout_stats() const;
     void fit_all_to_content();
     
     const std::map<std::string, std::unique_ptr<Panel>>& get_panels() const { return panels_; }
     
 private:
+    struct DeferredPanel {
+        PanelFactory factory;
+        bool prefetch = false;
+        std::future<std::unique_ptr<Panel>> build;  // valid while prefetched
+    };
+    
     PanelManager() = default;
     std::map<std::string, std::unique_ptr<Panel>> panels_;
+    std::map<std::string, DeferredPanel> deferred_panels_;
+    std::vector<std::pair<std::string, std::future<std::unique_ptr<Panel>>>> pending_swaps_;
+    std::vector<std::future<std::unique_ptr<Panel>>> superseded_swaps_;
     float peak_layout_duration_ms_ = 0.0f;
+    std::size_t last_render_allocations_ = 0;
+    float dpi_scale_ = 1.0f;  // last set_all_dpi_scale(), applied to panels built later
+    bool previous_frame_steady_ = false;
+    
+    // Built panel for `name`, building a deferred one first; nullptr if there is none
+    Panel* get_or_build_panel(const std::string& name);
+    void start_prefetch(DeferredPanel& deferred);
+    void drop_deferred_panel(const std::string& name);
+    
+    // Layout passes and open panels; a change means the frame is not steady state
+    std::pair<std::uint64_t, std::size_t> frame_signature() const;
+    void check_render_allocations(std::size_t allocations, std::pair<std::uint64_t, std::size_t> signature_before);
 };
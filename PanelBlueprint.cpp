@@ -0,0 +1,251 @@
+#include "PanelBlueprint.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace blueprint;
+
+// ============================================================================
+// PanelBlueprint Implementation
+// ============================================================================
+
+PanelBlueprint::~PanelBlueprint() {
+#ifndef _WIN32
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+    }
+#endif
+}
+
+std::unique_ptr<PanelBlueprint> PanelBlueprint::load(const std::string& path, std::string& error_message) {
+    std::unique_ptr<PanelBlueprint> result(new PanelBlueprint());
+
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_message = "Cannot open blueprint file: " + path;
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        error_message = "Cannot stat blueprint file: " + path;
+        return nullptr;
+    }
+
+    void* mapping = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        error_message = "Cannot map blueprint file: " + path;
+        return nullptr;
+    }
+
+    result->mapping_ = mapping;
+    result->mapping_size_ = static_cast<std::size_t>(st.st_size);
+    if (!result->attach(static_cast<const char*>(mapping), result->mapping_size_, error_message)) {
+        return nullptr;
+    }
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error_message = "Cannot open blueprint file: " + path;
+        return nullptr;
+    }
+    result->owned_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (!result->attach(result->owned_.data(), result->owned_.size(), error_message)) {
+        return nullptr;
+    }
+#endif
+
+    return result;
+}
+
+std::unique_ptr<PanelBlueprint> PanelBlueprint::from_bytes(std::vector<char> bytes, std::string& error_message) {
+    std::unique_ptr<PanelBlueprint> result(new PanelBlueprint());
+    result->owned_ = std::move(bytes);
+    if (!result->attach(result->owned_.data(), result->owned_.size(), error_message)) {
+        return nullptr;
+    }
+    return result;
+}
+
+bool PanelBlueprint::attach(const char* data, std::size_t size, std::string& error_message) {
+    if (size < sizeof(FileHeader)) {
+        error_message = "Blueprint file is truncated";
+        return false;
+    }
+
+    header_ = reinterpret_cast<const FileHeader*>(data);
+    if (header_->magic != kMagic) {
+        error_message = "Not a panel blueprint file";
+        return false;
+    }
+    if (header_->version != kVersion) {
+        error_message = "Unsupported blueprint version " + std::to_string(header_->version) +
+                        " (expected " + std::to_string(kVersion) + ")";
+        return false;
+    }
+
+    std::size_t nodes_offset = sizeof(FileHeader);
+    std::size_t strings_offset = nodes_offset + std::size_t(header_->node_count) * sizeof(Node);
+    std::size_t chars_offset = strings_offset + std::size_t(header_->string_count) * sizeof(StringEntry);
+    if (chars_offset + header_->string_bytes > size) {
+        error_message = "Blueprint tables exceed file size";
+        return false;
+    }
+
+    nodes_ = reinterpret_cast<const Node*>(data + nodes_offset);
+    strings_ = reinterpret_cast<const StringEntry*>(data + strings_offset);
+    chars_ = data + chars_offset;
+
+    for (std::uint32_t i = 0; i < header_->string_count; ++i) {
+        if (std::size_t(strings_[i].offset) + strings_[i].length > header_->string_bytes) {
+            error_message = "Blueprint string table is corrupt";
+            return false;
+        }
+    }
+
+    return validate_nodes(error_message);
+}
+
+bool PanelBlueprint::validate_nodes(std::string& error_message) const {
+    // Nodes still owed by the tree read so far: the root, then each node's children
+    std::uint64_t expected = header_->node_count > 0 ? 1 : 0;
+    // Kind and children still to come of each node whose children are being read
+    struct OpenNode {
+        NodeKind kind;
+        std::uint32_t remaining;
+    };
+    std::vector<OpenNode> open_nodes;
+    for (std::uint32_t i = 0; i < header_->node_count; ++i) {
+        const Node& node = nodes_[i];
+        if (static_cast<std::uint8_t>(node.kind) >= kNodeKindCount || node.justify >= kJustifyCount ||
+            node.align >= kAlignCount || node.align_self >= kAlignCount || node.variant >= kVariantCount ||
+            node.font_size >= kFontSizeCount ||
+            (node.kind == NodeKind::Column && (node.value < 0 || node.value >= kColumnKindCount))) {
+            error_message = "Blueprint node " + std::to_string(i) + " has an invalid value";
+            return false;
+        }
+
+        if (expected == 0) {
+            error_message = "Blueprint contains more than one root node";
+            return false;
+        }
+        expected = expected - 1 + node.child_count;
+        if (expected > header_->node_count - i - 1) {
+            error_message = "Blueprint node " + std::to_string(i) + " has more children than the table holds";
+            return false;
+        }
+
+        // Instantiation reads a repeat's one child as its row template and a
+        // table's children as its columns; any other shape would misparent
+        bool under_table = !open_nodes.empty() && open_nodes.back().kind == NodeKind::Table;
+        if ((node.kind == NodeKind::Column) != under_table) {
+            error_message = "Blueprint node " + std::to_string(i) +
+                            (under_table ? " is not a column but its parent is a table" : " is a column outside a table");
+            return false;
+        }
+        if (node.kind == NodeKind::Column && node.child_count != 0) {
+            error_message = "Blueprint node " + std::to_string(i) + " is a column with children";
+            return false;
+        }
+        if (node.kind == NodeKind::Repeat && node.child_count != 1) {
+            error_message = "Blueprint node " + std::to_string(i) + " is a repeat without exactly one row template";
+            return false;
+        }
+
+        if (!open_nodes.empty() && --open_nodes.back().remaining == 0) {
+            open_nodes.pop_back();
+        }
+        if (node.child_count > 0) {
+            open_nodes.push_back({node.kind, node.child_count});
+        }
+    }
+    return true;
+}
+
+std::string_view PanelBlueprint::string(std::uint32_t index) const {
+    if (index >= header_->string_count) {
+        return {};
+    }
+    return std::string_view(chars_ + strings_[index].offset, strings_[index].length);
+}
+
+// ============================================================================
+// PanelBlueprintWriter Implementation
+// ============================================================================
+
+void PanelBlueprintWriter::set_panel(std::string_view title, float width, float height) {
+    header_.title = intern(title);
+    header_.width = width;
+    header_.height = height;
+}
+
+std::size_t PanelBlueprintWriter::add_node(NodeKind kind) {
+    Node node;
+    node.kind = kind;
+    nodes_.push_back(node);
+    return nodes_.size() - 1;
+}
+
+std::uint32_t PanelBlueprintWriter::intern(std::string_view value) {
+    auto it = interned_.find(std::string(value));
+    if (it != interned_.end()) {
+        return it->second;
+    }
+
+    auto index = static_cast<std::uint32_t>(strings_.size());
+    strings_.push_back({static_cast<std::uint32_t>(chars_.size()), static_cast<std::uint32_t>(value.size())});
+    chars_.append(value);
+    interned_.emplace(std::string(value), index);
+    return index;
+}
+
+std::vector<char> PanelBlueprintWriter::serialize() const {
+    FileHeader header = header_;
+    header.node_count = static_cast<std::uint32_t>(nodes_.size());
+    header.string_count = static_cast<std::uint32_t>(strings_.size());
+    header.string_bytes = static_cast<std::uint32_t>(chars_.size());
+
+    std::vector<char> bytes(sizeof(header) + nodes_.size() * sizeof(Node) +
+                            strings_.size() * sizeof(StringEntry) + chars_.size());
+    char* cursor = bytes.data();
+    auto append = [&cursor](const void* data, std::size_t size) {
+        if (size > 0) {
+            std::memcpy(cursor, data, size);
+            cursor += size;
+        }
+    };
+    append(&header, sizeof(header));
+    append(nodes_.data(), nodes_.size() * sizeof(Node));
+    append(strings_.data(), strings_.size() * sizeof(StringEntry));
+    append(chars_.data(), chars_.size());
+    return bytes;
+}
+
+bool PanelBlueprintWriter::write(const std::string& path, std::string& error_message) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        error_message = "Cannot open blueprint output file: " + path;
+        return false;
+    }
+
+    std::vector<char> bytes = serialize();
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+    if (!file) {
+        error_message = "Failed writing blueprint file: " + path;
+        return false;
+    }
+    return true;
+}
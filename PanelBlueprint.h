@@ -0,0 +1,189 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief On-disk layout of a compiled panel ("blueprint")
+ *
+ * A blueprint is the flat binary counterpart of a panel XML file. Every string
+ * is interned once into a string table, element and input types are resolved
+ * to enums, numbers and style values are stored pre-parsed, and the widget hierarchy is stored
+ * as a pre-order node table where each node records its direct child count.
+ * The file layout is the in-memory layout, so a memory-mapped blueprint is
+ * used as-is without a decoding pass.
+ *
+ * File layout: FileHeader | Node[node_count] | StringEntry[string_count] | char[string_bytes]
+ */
+namespace blueprint {
+
+constexpr std::uint32_t kMagic = 0x42505849; // "IXPB" in little-endian byte order
+constexpr std::uint32_t kVersion = 4;
+constexpr std::uint32_t kNoString = 0xFFFFFFFFu;
+
+enum class NodeKind : std::uint8_t {
+    Label,
+    InputText,
+    InputNumber,
+    Checkbox,
+    Radio,
+    Button,
+    HLayout,
+    VLayout,
+    Repeat,     // bind = source collection, group = row alias, one child: the row template
+    Table,      // bind = source collection, group = row alias, children: its columns
+    Column,     // text = header, bind = cell path, group = choice options, value = TableColumn::Kind
+};
+
+// One past the largest value each enum-valued Node field may hold; loading
+// rejects anything outside. XmlParser checks these against the widget enums.
+constexpr std::uint8_t kNodeKindCount = static_cast<std::uint8_t>(NodeKind::Column) + 1;
+constexpr std::uint8_t kJustifyCount = 6;
+constexpr std::uint8_t kAlignCount = 6;
+constexpr std::uint8_t kVariantCount = 4;
+constexpr std::uint8_t kFontSizeCount = 3;
+constexpr std::int32_t kColumnKindCount = 3;
+
+enum NodeFlags : std::uint16_t {
+    kHasWidth   = 1 << 0,
+    kHasHeight  = 1 << 1,
+    kHasFlex    = 1 << 2,
+    kHasMargin  = 1 << 3,
+    kHasPadding = 1 << 4,
+    kHasGap     = 1 << 5,
+    kDisabled   = 1 << 6,
+    kBold       = 1 << 7,
+    kStretch    = 1 << 8,
+    kWrap       = 1 << 9,
+};
+
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t node_count;
+    std::uint32_t string_count;
+    std::uint32_t string_bytes;
+    std::uint32_t title;        // string index
+    float width;
+    float height;
+};
+
+struct StringEntry {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+struct Node {
+    NodeKind kind = NodeKind::Label;
+    std::uint8_t reserved = 0;
+    std::uint16_t flags = 0;
+    std::uint32_t child_count = 0;  // direct children, stored in pre-order after this node
+
+    // Element attributes (string indices)
+    std::uint32_t id = kNoString;
+    std::uint32_t text = kNoString;
+    std::uint32_t bind = kNoString;
+    std::uint32_t group = kNoString;
+    std::int32_t value = 0;
+
+    // Layout and spacing, valid when the matching kHas* flag is set
+    float width = 0.0f;
+    float height = 0.0f;
+    float flex = 0.0f;
+    float margin = 0.0f;
+    float padding = 0.0f;
+    float gap = 0.0f;
+
+    // Resolved style: Widget::Style enum values and packed colors
+    std::uint8_t justify = 0;
+    std::uint8_t align = 0;
+    std::uint8_t align_self = 0;
+    std::uint8_t variant = 0;
+    std::uint8_t font_size = 0;
+    std::uint8_t style_reserved[3] = {};
+    std::uint32_t text_color = 0;
+    std::uint32_t bg_color = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+static_assert(std::is_trivially_copyable_v<StringEntry>);
+static_assert(std::is_trivially_copyable_v<Node>);
+static_assert(sizeof(FileHeader) % alignof(Node) == 0);
+static_assert(sizeof(Node) % alignof(StringEntry) == 0);
+
+} // namespace blueprint
+
+/**
+ * @brief Read-only view over a compiled panel blueprint
+ *
+ * Blueprints loaded from disk are memory-mapped; the node table and string
+ * table point straight into the mapping. Blueprints compiled in memory own a
+ * buffer with the same layout. A blueprint is immutable once created, so one
+ * instance can be shared by every thread instantiating panels from it. Use
+ * XmlParser to compile XML into a blueprint and to build widget trees from one.
+ */
+class PanelBlueprint {
+public:
+    ~PanelBlueprint();
+
+    PanelBlueprint(const PanelBlueprint&) = delete;
+    PanelBlueprint& operator=(const PanelBlueprint&) = delete;
+
+    static std::unique_ptr<PanelBlueprint> load(const std::string& path, std::string& error_message);
+    static std::unique_ptr<PanelBlueprint> from_bytes(std::vector<char> bytes, std::string& error_message);
+
+    std::string_view title() const { return string(header_->title); }
+    float width() const { return header_->width; }
+    float height() const { return header_->height; }
+
+    const blueprint::Node* nodes() const { return nodes_; }
+    std::size_t node_count() const { return header_->node_count; }
+
+    std::string_view string(std::uint32_t index) const;
+
+private:
+    PanelBlueprint() = default;
+
+    bool attach(const char* data, std::size_t size, std::string& error_message);
+    // Enum fields in range, child counts forming a single pre-order tree, and
+    // repeats, tables and columns nested the way instantiation reads them
+    bool validate_nodes(std::string& error_message) const;
+
+    std::vector<char> owned_;
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+
+    const blueprint::FileHeader* header_ = nullptr;
+    const blueprint::Node* nodes_ = nullptr;
+    const blueprint::StringEntry* strings_ = nullptr;
+    const char* chars_ = nullptr;
+};
+
+/**
+ * @brief Accumulates nodes and interned strings and serializes a blueprint
+ */
+class PanelBlueprintWriter {
+public:
+    void set_panel(std::string_view title, float width, float height);
+
+    std::size_t add_node(blueprint::NodeKind kind);
+    blueprint::Node& node(std::size_t index) { return nodes_[index]; }
+    std::size_t node_count() const { return nodes_.size(); }
+
+    std::uint32_t intern(std::string_view value);
+
+    std::vector<char> serialize() const;
+    bool write(const std::string& path, std::string& error_message) const;
+
+private:
+    blueprint::FileHeader header_{blueprint::kMagic, blueprint::kVersion, 0, 0, 0, blueprint::kNoString, 400.0f, 300.0f};
+    std::vector<blueprint::Node> nodes_;
+    std::vector<blueprint::StringEntry> strings_;
+    std::string chars_;
+    std::unordered_map<std::string, std::uint32_t> interned_;
+};
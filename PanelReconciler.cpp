@@ -0,0 +1,138 @@
+#include "PanelReconciler.h"
+#include "WidgetArena.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// PanelReconciler Implementation
+// ============================================================================
+
+ReconcileStats PanelReconciler::reconcile(Panel& live, Panel& fresh) {
+    ReconcileStats stats;
+
+    if (live.get_title() != fresh.get_title()) {
+        live.set_title(fresh.get_title());
+    }
+    // Panel sizes are logical in XML; only force a resize when the XML changed them.
+    // A background build may already be at the live scale, so go through its own.
+    float scale = live.get_dpi_scale() / fresh.get_dpi_scale();
+    if (live.get_width() != fresh.get_width() * scale) {
+        live.set_width(fresh.get_width() * scale);
+    }
+    if (live.get_height() != fresh.get_height() * scale) {
+        live.set_height(fresh.get_height() * scale);
+    }
+
+    Widget* live_root = live.get_root_widget();
+    Widget* fresh_root = fresh.get_root_widget();
+    if (live_root && fresh_root && live_root->get_id() == fresh_root->get_id() && same_kind(*live_root, *fresh_root)) {
+        reconcile_widget(*live_root, *fresh_root, stats);
+        live.invalidate_layout();
+    } else {
+        if (live_root) {
+            stats.removed += count_widgets(*live_root);
+        }
+        if (fresh_root) {
+            stats.created += count_widgets(*fresh_root);
+        }
+        live.set_root_widget(fresh_root ? adopt(*fresh_root) : nullptr);
+    }
+
+    return stats;
+}
+
+std::unique_ptr<Widget> PanelReconciler::adopt(const Widget& fresh) {
+    // Taking the parsed widget itself would pin the fresh panel's whole arena
+    // for as long as it lives; a heap copy lets the arena go with the panel
+    WidgetArena::Scope heap(nullptr);
+    return fresh.clone();
+}
+
+bool PanelReconciler::same_kind(const Widget& a, const Widget& b) {
+    return a.get_kind() == b.get_kind();
+}
+
+void PanelReconciler::reconcile_widget(Widget& live, Widget& fresh, ReconcileStats& stats) {
+    if (live.patch_from(fresh)) {
+        ++stats.patched;
+    } else {
+        ++stats.unchanged;
+    }
+
+    auto* live_container = widget_cast<ContainerWidget>(&live);
+    if (live_container) {
+        reconcile_children(*live_container, static_cast<ContainerWidget&>(fresh), stats);
+    }
+}
+
+void PanelReconciler::reconcile_children(ContainerWidget& live, ContainerWidget& fresh, ReconcileStats& stats) {
+    std::vector<std::unique_ptr<Widget>> old_children = std::move(live.children_);
+    live.children_.clear();
+
+    // Candidate positions by id; anonymous widgets share the "" bucket and match in order
+    std::unordered_map<std::string, std::vector<std::size_t>> positions;
+    for (std::size_t i = 0; i < old_children.size(); ++i) {
+        positions[old_children[i]->get_id()].push_back(i);
+    }
+
+    std::vector<std::unique_ptr<Widget>> new_children;
+    new_children.reserve(fresh.children_.size());
+
+    for (auto& fresh_child : fresh.children_) {
+        std::unique_ptr<Widget> match;
+        auto it = positions.find(fresh_child->get_id());
+        if (it != positions.end()) {
+            auto& candidates = it->second;
+            for (auto pos = candidates.begin(); pos != candidates.end(); ++pos) {
+                if (same_kind(*old_children[*pos], *fresh_child)) {
+                    match = std::move(old_children[*pos]);
+                    candidates.erase(pos);
+                    break;
+                }
+            }
+        }
+
+        if (match) {
+            reconcile_widget(*match, *fresh_child, stats);
+            new_children.push_back(std::move(match));
+        } else {
+            auto adopted = adopt(*fresh_child);
+            // The parsed tree's config and index go away with the fresh panel
+            adopted->set_yoga_config(live.get_yoga_config());
+            adopted->set_widget_index(live.get_widget_index());
+            stats.created += count_widgets(*adopted);
+            new_children.push_back(std::move(adopted));
+        }
+    }
+
+    // Leave the Yoga child list alone (and clean) unless membership or order changed
+    YGNodeRef node = live.get_yoga_node();
+    bool same_order = node && YGNodeGetChildCount(node) == new_children.size();
+    for (std::size_t i = 0; same_order && i < new_children.size(); ++i) {
+        same_order = YGNodeGetChild(node, i) == new_children[i]->get_yoga_node();
+    }
+    if (node && !same_order) {
+        YGNodeRemoveAllChildren(node);
+        for (std::size_t i = 0; i < new_children.size(); ++i) {
+            YGNodeInsertChild(node, new_children[i]->get_yoga_node(), i);
+        }
+    }
+
+    for (const auto& old_child : old_children) {
+        if (old_child) {
+            stats.removed += count_widgets(*old_child);
+        }
+    }
+
+    live.children_ = std::move(new_children);
+}
+
+std::size_t PanelReconciler::count_widgets(const Widget& widget) {
+    std::size_t count = 0;
+    walk_widgets(widget, [&count](const Widget&) {
+        ++count;
+        return true;
+    });
+    return count;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "Panel.h"
+#include "Widget.h"
+#include <cstddef>
+#include <memory>
+
+/**
+ * @brief Counts of what a reconcile pass did to the live widget tree
+ */
+struct ReconcileStats {
+    std::size_t unchanged = 0;
+    std::size_t patched = 0;
+    std::size_t created = 0;
+    std::size_t removed = 0;
+};
+
+/**
+ * @brief Applies a freshly parsed panel to a live one for hot reload
+ *
+ * Widgets are matched by id and dynamic type (anonymous widgets by order
+ * among their anonymous siblings). Matched widgets are patched in place with
+ * Widget::patch_from, so they keep their Yoga nodes and UI state; only
+ * unmatched widgets are copied over from the new tree or destroyed. A
+ * container's Yoga children are rewired only when its child list changed, so
+ * the next layout pass recomputes just the dirty subtrees.
+ */
+class PanelReconciler {
+public:
+    static ReconcileStats reconcile(Panel& live, Panel& fresh);
+
+private:
+    // Heap copy of a parsed subtree, so nothing in the live tree lives in the fresh panel's arena
+    static std::unique_ptr<Widget> adopt(const Widget& fresh);
+    static bool same_kind(const Widget& a, const Widget& b);
+    static void reconcile_widget(Widget& live, Widget& fresh, ReconcileStats& stats);
+    static void reconcile_children(ContainerWidget& live, ContainerWidget& fresh, ReconcileStats& stats);
+    static std::size_t count_widgets(const Widget& widget);
+};
@@ -0,0 +1,138 @@
+#include "RepeatWidget.h"
+
+namespace {
+
+void collect_preorder(Widget& widget, std::vector<Widget*>& out) {
+    walk_widgets(widget, [&out](Widget& node) {
+        out.push_back(&node);
+        return true;
+    });
+}
+
+} // namespace
+
+// ============================================================================
+// RepeatWidget Implementation
+// ============================================================================
+
+RepeatWidget::RepeatWidget(const std::string& id, const std::string& source)
+    : ContainerWidget(kKind, id), source_(source) {
+    setup_yoga_layout();
+}
+
+void RepeatWidget::setup_yoga_layout() {
+    if (yoga_node_) {
+        YGNodeStyleSetFlexDirection(yoga_node_, YGFlexDirectionColumn);
+    }
+    ContainerWidget::apply_styles();
+}
+
+void RepeatWidget::render() {
+    if (render_children_positioned(true)) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < children_.size(); ++i) {
+        ImGui::PushID(static_cast<int>(i));
+        children_[i]->render();
+        ImGui::PopID();
+    }
+}
+
+void RepeatWidget::set_template(std::unique_ptr<Widget> prototype, std::vector<TemplateBinding> bindings) {
+    prototype_ = std::move(prototype);
+    bindings_ = std::move(bindings);
+
+    template_ids_.clear();
+    if (prototype_) {
+        scratch_.clear();
+        collect_preorder(*prototype_, scratch_);
+        for (Widget* widget : scratch_) {
+            template_ids_.push_back(widget->get_id());
+        }
+    }
+}
+
+void RepeatWidget::bind_source(AppData* data, const BindingRegistry& registry) {
+    app_data_ = data;
+    collection_size_ = registry.find_collection(source_);
+}
+
+bool RepeatWidget::sync_rows() {
+    if (!prototype_ || !app_data_ || !collection_size_) {
+        return false;
+    }
+
+    std::size_t row_count = (*collection_size_)(*app_data_);
+    if (row_count == children_.size()) {
+        return false;
+    }
+
+    // Trim from the end
+    while (children_.size() > row_count) {
+        if (yoga_node_) {
+            YGNodeRemoveChild(yoga_node_, children_.back()->get_yoga_node());
+        }
+        children_.pop_back();
+    }
+
+    // The collection may have reallocated, so rebind the rows that stay
+    for (std::size_t row = 0; row < children_.size(); ++row) {
+        bind_row(*children_[row], row);
+    }
+
+    children_.reserve(row_count);
+    for (std::size_t row = children_.size(); row < row_count; ++row) {
+        auto stamped = prototype_->clone();
+        bind_row(*stamped, row);
+        add_child(std::move(stamped));
+    }
+    return true;
+}
+
+void RepeatWidget::bind_row(Widget& row, std::size_t row_index) {
+    // Pre-order walk, matching the indices recorded while parsing the template
+    scratch_.clear();
+    collect_preorder(row, scratch_);
+
+    const std::string suffix = "_" + std::to_string(row_index);
+    for (std::size_t i = 0; i < scratch_.size() && i < template_ids_.size(); ++i) {
+        if (!template_ids_[i].empty()) {
+            scratch_[i]->set_id(template_ids_[i] + suffix);
+        }
+    }
+
+    for (const auto& entry : bindings_) {
+        if (entry.index < scratch_.size()) {
+            bind_widget(*scratch_[entry.index], entry.binding.with_index(row_index).resolve(*app_data_));
+        }
+    }
+}
+
+bool RepeatWidget::patch_from(const Widget& source) {
+    bool changed = Widget::patch_from(source);
+    const auto& repeat = static_cast<const RepeatWidget&>(source);
+    if (source_ != repeat.source_) {
+        source_ = repeat.source_;
+        changed = true;
+    }
+
+    // Stamped rows are reconciled as children; keep the new template for future rows
+    set_template(repeat.prototype_ ? repeat.prototype_->clone() : nullptr, repeat.bindings_);
+    app_data_ = repeat.app_data_;
+    collection_size_ = repeat.collection_size_;
+    if (changed) {
+        notify_changed();
+    }
+    return changed;
+}
+
+std::unique_ptr<Widget> RepeatWidget::clone() const {
+    auto copy = std::make_unique<RepeatWidget>(id_, source_);
+    copy->copy_layout_from(*this);
+    copy->set_template(prototype_ ? prototype_->clone() : nullptr, bindings_);
+    copy->app_data_ = app_data_;
+    copy->collection_size_ = collection_size_;
+    copy->sync_rows();
+    return copy;
+}
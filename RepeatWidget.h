@@ -0,0 +1,70 @@
+#pragma once
+#include "Widget.h"
+#include "DataBinding.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Binding of one widget inside a row template
+ *
+ * `index` is the widget's position in a pre-order walk of the template.
+ * Indexed bindings are resolved per row with CompiledBinding::with_index.
+ */
+struct TemplateBinding {
+    std::size_t index = 0;
+    CompiledBinding binding;
+};
+
+/**
+ * @brief Vertical container that stamps one row per element of a collection
+ *
+ * Created from `<repeat source="cities" as="city">`. The single child element
+ * is parsed once into a prototype row; rows are produced by cloning the
+ * prototype and resolving its bindings for the row index, so adding rows
+ * never goes back to the XML. Stamped ids get a `_<row>` suffix and each row
+ * renders under its own ImGui ID scope.
+ *
+ * The row count follows the collection size: before each layout check the
+ * owning Panel calls sync_children(), which adds or drops rows at the end
+ * when the size changed. That dirties the Yoga tree, so the new rows are
+ * laid out and drawn in the same frame.
+ */
+class RepeatWidget : public ContainerWidget {
+public:
+    static constexpr WidgetKind kKind = WidgetKind::Repeat;
+    
+    explicit RepeatWidget(const std::string& id = "", const std::string& source = "");
+
+    void render() override;
+    bool patch_from(const Widget& source) override;
+    std::unique_ptr<Widget> clone() const override;
+
+    const std::string& get_source() const { return source_; }
+    const Widget* get_prototype() const { return prototype_.get(); }
+
+    void set_template(std::unique_ptr<Widget> prototype, std::vector<TemplateBinding> bindings);
+    void bind_source(AppData* data, const BindingRegistry& registry);
+
+    /**
+     * @brief Stamps or drops rows so there is one per collection element
+     * @return true if the row count changed
+     */
+    bool sync_rows();
+    bool sync_children() override { return sync_rows(); }
+
+protected:
+    void setup_yoga_layout() override;
+
+private:
+    std::string source_;
+    std::unique_ptr<Widget> prototype_;
+    std::vector<TemplateBinding> bindings_;
+    std::vector<std::string> template_ids_;  // pre-order ids of the prototype
+    AppData* app_data_ = nullptr;
+    const BindingRegistry::CollectionSize* collection_size_ = nullptr;
+    std::vector<Widget*> scratch_;  // pre-order walk of the row being bound
+
+    void bind_row(Widget& row, std::size_t row_index);
+};
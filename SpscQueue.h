@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
+/**
+ * @brief Bounded lock-free queue for one producer thread and one consumer thread
+ *
+ * push() and pop() never block or allocate; push() fails when the queue is
+ * full and the producer decides how to degrade.
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+public:
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+    bool push(const T& value) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots_[head & (Capacity - 1)] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = slots_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+private:
+    // Producer and consumer indices on separate cache lines
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::array<T, Capacity> slots_{};
+};
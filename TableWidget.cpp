@@ -0,0 +1,222 @@
+#include "TableWidget.h"
+#include <algorithm>
+#include <cfloat>
+#include <charconv>
+#include <climits>
+
+namespace {
+
+constexpr ImGuiTableFlags kTableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY |
+                                        ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp;
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && text.front() == ' ') text.remove_prefix(1);
+    while (!text.empty() && text.back() == ' ') text.remove_suffix(1);
+    return text;
+}
+
+} // namespace
+
+// ============================================================================
+// Table Columns
+// ============================================================================
+
+bool TableColumn::parse_kind(std::string_view name, Kind& out) {
+    if (name == "input") {
+        out = Kind::Input;
+    } else if (name == "label") {
+        out = Kind::Label;
+    } else if (name == "choice") {
+        out = Kind::Choice;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool TableColumn::parse_choices(std::string_view text, std::vector<TableChoice>& out) {
+    out.clear();
+    while (!text.empty()) {
+        std::size_t comma = text.find(',');
+        std::string_view entry = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+
+        std::size_t colon = entry.rfind(':');
+        if (colon == std::string_view::npos) {
+            return false;
+        }
+        std::string_view label = trim(entry.substr(0, colon));
+        std::string_view value = trim(entry.substr(colon + 1));
+
+        TableChoice choice;
+        choice.label = std::string(label);
+        auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), choice.value);
+        if (label.empty() || ec != std::errc() || end != value.data() + value.size()) {
+            return false;
+        }
+        out.push_back(std::move(choice));
+    }
+    return !out.empty();
+}
+
+// ============================================================================
+// TableWidget Implementation
+// ============================================================================
+
+TableWidget::TableWidget(const std::string& id, const std::string& source)
+    : Widget(kKind, id), source_(source) {
+    setup_yoga_layout();
+}
+
+void TableWidget::render() {
+    if (columns_.empty()) {
+        return;
+    }
+
+    if (style_.disabled) {
+        ImGui::BeginDisabled();
+    }
+
+    // A zero extent lets BeginTable fill the space left in the window
+    ImVec2 size(layout_.width, layout_.height);
+    if (ImGui::BeginTable(id_.empty() ? "##table" : id_.c_str(), static_cast<int>(columns_.size()), kTableFlags,
+                          size)) {
+        for (const auto& column : columns_) {
+            ImGui::TableSetupColumn(column.header.c_str(), ImGuiTableColumnFlags_WidthStretch, column.weight);
+        }
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        // Only the rows inside the scroll view are visited
+        std::size_t row_count = std::min<std::size_t>(get_row_count(), INT_MAX);
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(row_count));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                ImGui::TableNextRow();
+                ImGui::PushID(row);
+                for (std::size_t c = 0; c < columns_.size(); ++c) {
+                    ImGui::TableSetColumnIndex(static_cast<int>(c));
+                    ImGui::PushID(static_cast<int>(c));
+                    render_cell(columns_[c], static_cast<std::size_t>(row));
+                    ImGui::PopID();
+                }
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    if (style_.disabled) {
+        ImGui::EndDisabled();
+    }
+}
+
+void TableWidget::render_cell(const TableColumn& column, std::size_t row) {
+    void* field = column.access ? column.access(row) : nullptr;
+    if (!field) {
+        return;
+    }
+
+    bool editable = column.kind != TableColumn::Kind::Label;
+    if (editable) {
+        ImGui::SetNextItemWidth(-FLT_MIN);
+    }
+
+    switch (column.type) {
+    case BindingType::String: {
+        auto* text = static_cast<std::string*>(field);
+        if (editable) {
+            widget_input::input_text("##cell", *text);
+        } else {
+            ImGui::TextUnformatted(text->data(), text->data() + text->size());
+        }
+        break;
+    }
+    case BindingType::Float: {
+        auto* value = static_cast<float*>(field);
+        if (editable) {
+            ImGui::InputFloat("##cell", value);
+        } else {
+            ImGui::Text("%.3f", *value);
+        }
+        break;
+    }
+    case BindingType::Int: {
+        auto* value = static_cast<int*>(field);
+        if (column.kind == TableColumn::Kind::Choice) {
+            const char* preview = "";
+            for (const auto& choice : column.choices) {
+                if (choice.value == *value) {
+                    preview = choice.label.c_str();
+                    break;
+                }
+            }
+            if (ImGui::BeginCombo("##cell", preview)) {
+                for (const auto& choice : column.choices) {
+                    bool selected = choice.value == *value;
+                    if (ImGui::Selectable(choice.label.c_str(), selected)) {
+                        *value = choice.value;
+                    }
+                    if (selected) {
+                        ImGui::SetItemDefaultFocus();
+                    }
+                }
+                ImGui::EndCombo();
+            }
+        } else if (editable) {
+            // No step buttons: they would crowd the cell
+            ImGui::InputInt("##cell", value, 0, 0);
+        } else {
+            ImGui::Text("%d", *value);
+        }
+        break;
+    }
+    case BindingType::Bool: {
+        auto* value = static_cast<bool*>(field);
+        if (editable) {
+            ImGui::Checkbox("##cell", value);
+        } else {
+            ImGui::TextUnformatted(*value ? "true" : "false");
+        }
+        break;
+    }
+    case BindingType::None:
+        break;
+    }
+}
+
+bool TableWidget::patch_from(const Widget& source) {
+    bool changed = Widget::patch_from(source);
+    const auto& table = static_cast<const TableWidget&>(source);
+    if (source_ != table.source_ || columns_.size() != table.columns_.size()) {
+        changed = true;
+    } else {
+        for (std::size_t i = 0; i < columns_.size(); ++i) {
+            const TableColumn& live = columns_[i];
+            const TableColumn& fresh = table.columns_[i];
+            if (live.header != fresh.header || live.kind != fresh.kind || live.type != fresh.type ||
+                live.weight != fresh.weight || live.choices != fresh.choices) {
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    // Accessors are always taken: they capture the data the new tree was bound to
+    source_ = table.source_;
+    columns_ = table.columns_;
+    row_count_ = table.row_count_;
+    if (changed) {
+        notify_changed();
+    }
+    return changed;
+}
+
+std::unique_ptr<Widget> TableWidget::clone() const {
+    auto copy = std::make_unique<TableWidget>(id_, source_);
+    copy->copy_layout_from(*this);
+    copy->columns_ = columns_;
+    copy->row_count_ = row_count_;
+    return copy;
+}
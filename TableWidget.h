@@ -0,0 +1,86 @@
+#pragma once
+#include "Widget.h"
+#include "DataBinding.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief One entry of a choice column: the label shown and the value stored
+ */
+struct TableChoice {
+    std::string label;
+    int value = 0;
+
+    bool operator==(const TableChoice&) const = default;
+};
+
+/**
+ * @brief Column of a TableWidget
+ *
+ * `access` returns the address of the column's field in a given row (or
+ * nullptr past the end); `type` says how to read it. Input columns edit the
+ * field with the widget matching its type, label columns only display it,
+ * and choice columns edit an int through a combo of `choices`.
+ */
+struct TableColumn {
+    enum class Kind : std::uint8_t { Input, Label, Choice };
+
+    std::string header;
+    Kind kind = Kind::Input;
+    BindingType type = BindingType::None;
+    float weight = 1.0f;  // share of the table width
+    std::vector<TableChoice> choices;
+    std::function<void*(std::size_t row)> access;
+
+    static bool parse_kind(std::string_view name, Kind& out);
+
+    /**
+     * @brief Parses `Label:value,Label:value` into choices
+     */
+    static bool parse_choices(std::string_view text, std::vector<TableChoice>& out);
+};
+
+/**
+ * @brief Virtualized table over a collection, one row per element
+ *
+ * Created from `<table source="cities" as="city">` with `<column>` children,
+ * or with TableBuilder. The table is a single Yoga node whatever the row
+ * count: rows are never turned into widgets. render() draws through
+ * ImGui::BeginTable and ImGuiListClipper, so only the rows inside the
+ * scroll view are visited, and cells format straight into ImGui's buffers
+ * without allocating. Memory does not depend on the collection size.
+ *
+ * Give the table a height or a flex share; without one it fills the space
+ * left in the window.
+ */
+class TableWidget : public Widget {
+public:
+    static constexpr WidgetKind kKind = WidgetKind::Table;
+    
+    using RowCount = std::function<std::size_t()>;
+
+    explicit TableWidget(const std::string& id = "", const std::string& source = "");
+
+    void render() override;
+    bool patch_from(const Widget& source) override;
+    std::unique_ptr<Widget> clone() const override;
+
+    const std::string& get_source() const { return source_; }
+    const std::vector<TableColumn>& get_columns() const { return columns_; }
+    std::size_t get_row_count() const { return row_count_ ? row_count_() : 0; }
+
+    void add_column(TableColumn column) { columns_.push_back(std::move(column)); }
+    void set_row_count(RowCount row_count) { row_count_ = std::move(row_count); }
+
+private:
+    std::string source_;
+    std::vector<TableColumn> columns_;
+    RowCount row_count_;
+
+    void render_cell(const TableColumn& column, std::size_t row);
+};
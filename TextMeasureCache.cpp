@@ -0,0 +1,157 @@
+#include "TextMeasureCache.h"
+#include <cmath>
+#include <functional>
+
+namespace {
+
+thread_local std::size_t t_estimates = 0;
+
+// Rough extent for text that cannot be measured with ImGui yet
+ImVec2 estimate_extent(std::string_view text, float font_size) {
+    return ImVec2(static_cast<float>(text.size()) * font_size * 0.5f, font_size);
+}
+
+// ImGuiStyle::ScaleAllSizes truncates to whole pixels, so a style scaled to
+// 1.5x reads back up to a pixel short of the logical value. Metrics within a
+// device pixel of each other count as the same, so a DPI change alone never
+// restyles or re-measures the panels.
+bool same_metrics(const TextMeasureCache::Metrics& a, const TextMeasureCache::Metrics& b, float global_scale) {
+    auto same = [global_scale](float x, float y) { return std::abs(x - y) * global_scale < 1.0f; };
+    return same(a.font_size, b.font_size) && same(a.frame_padding.x, b.frame_padding.x) &&
+           same(a.frame_padding.y, b.frame_padding.y) && same(a.item_inner_spacing, b.item_inner_spacing);
+}
+
+} // namespace
+
+// ============================================================================
+// TextMeasureCache Implementation
+// ============================================================================
+
+TextMeasureCache& TextMeasureCache::instance() {
+    static TextMeasureCache cache;
+    return cache;
+}
+
+std::size_t TextMeasureCache::KeyHash::operator()(const Key& key) const {
+    std::size_t hash = std::hash<std::string_view>()(key.text);
+    hash ^= std::hash<const void*>()(key.font) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.size) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+void TextMeasureCache::capture_metrics() {
+    if (!ImGui::GetCurrentContext()) {
+        return;
+    }
+
+    float global_scale = ImGui::GetIO().FontGlobalScale;
+    if (global_scale <= 0.0f) {
+        global_scale = 1.0f;
+    }
+    const ImGuiStyle& style = ImGui::GetStyle();
+
+    Metrics metrics;
+    metrics.font_size = ImGui::GetFontSize() / global_scale;
+    metrics.frame_padding = ImVec2(style.FramePadding.x / global_scale, style.FramePadding.y / global_scale);
+    metrics.item_inner_spacing = style.ItemInnerSpacing.x / global_scale;
+    const ImFont* font = ImGui::GetFont();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ui_thread_ = std::this_thread::get_id();
+    global_scale_ = global_scale;
+    if (font != font_) {
+        // A new font (or an atlas rebuilt in place) invalidates every extent
+        font_ = font;
+        entries_.clear();
+        index_.clear();
+        bytes_ = 0;
+        ++metrics_generation_;
+    }
+    if (!same_metrics(metrics, metrics_, global_scale)) {
+        metrics_ = metrics;
+        ++metrics_generation_;
+    }
+}
+
+TextMeasureCache::Metrics TextMeasureCache::get_metrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return metrics_;
+}
+
+std::uint32_t TextMeasureCache::get_metrics_generation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return metrics_generation_;
+}
+
+ImVec2 TextMeasureCache::measure(std::string_view text, float text_scale) {
+    if (text.empty()) {
+        return ImVec2(0.0f, 0.0f);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    float size = metrics_.font_size * global_scale_ * text_scale;
+    auto it = index_.find(Key{font_, size, text});
+    if (it != index_.end()) {
+        ++hits_;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->extent;
+    }
+
+    // ImGui is single-threaded and has no font before its first frame
+    bool can_measure = font_ && std::this_thread::get_id() == ui_thread_ && ImGui::GetCurrentContext() &&
+                       ImGui::GetFont() == font_;
+    if (!can_measure) {
+        ++t_estimates;
+        return estimate_extent(text, metrics_.font_size * text_scale);
+    }
+
+    ++misses_;
+    ImVec2 extent = ImGui::CalcTextSize(text.data(), text.data() + text.size());
+    extent.x *= text_scale / global_scale_;
+    extent.y *= text_scale / global_scale_;
+
+    entries_.push_front(Entry{font_, size, std::string(text), extent});
+    const Entry& entry = entries_.front();
+    index_.emplace(Key{entry.font, entry.size, entry.text}, entries_.begin());
+    bytes_ += entry_bytes(entry);
+    evict_to_budget();
+    return extent;
+}
+
+std::size_t TextMeasureCache::thread_estimate_count() {
+    return t_estimates;
+}
+
+std::size_t TextMeasureCache::get_budget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_;
+}
+
+void TextMeasureCache::set_budget(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = bytes;
+    evict_to_budget();
+}
+
+void TextMeasureCache::evict_to_budget() {
+    while (bytes_ > budget_ && !entries_.empty()) {
+        const Entry& oldest = entries_.back();
+        index_.erase(Key{oldest.font, oldest.size, oldest.text});
+        bytes_ -= entry_bytes(oldest);
+        entries_.pop_back();
+    }
+}
+
+void TextMeasureCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+    hits_ = 0;
+    misses_ = 0;
+}
+
+TextMeasureCache::Stats TextMeasureCache::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Stats{entries_.size(), bytes_, hits_, misses_};
+}
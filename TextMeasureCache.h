@@ -0,0 +1,121 @@
+#pragma once
+#include "imgui.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @brief Shared cache of text extents for Yoga measure functions
+ *
+ * Entries are keyed on (font, pixel size, string), so ImGui::CalcTextSize
+ * runs once per distinct string and scale. The cache holds at most
+ * get_budget() bytes, counting each entry's string and bookkeeping, and
+ * evicts the least recently used entries beyond that.
+ *
+ * Text is only measured with ImGui on the UI thread, inside a frame: the
+ * thread that last called capture_metrics(). Layouts run on pool workers,
+ * or before ImGui has a font, get an estimate for uncached text instead.
+ * thread_estimate_count() lets the caller notice and measure again on the
+ * UI thread.
+ *
+ * Metrics and extents are logical: ImGui's pixel sizes divided by
+ * FontGlobalScale, which the application keeps equal to the panels' DPI
+ * scale. A DPI change then leaves measured sizes alone and only moves the
+ * scale panels apply to their layout. Metrics are only replaced when they
+ * move by a device pixel or more, which absorbs the rounding of a style
+ * scaled with ImGuiStyle::ScaleAllSizes.
+ */
+class TextMeasureCache {
+public:
+    /**
+     * @brief ImGui sizes that widget measurements depend on, in logical units
+     */
+    struct Metrics {
+        float font_size = 13.0f;
+        ImVec2 frame_padding = ImVec2(4.0f, 3.0f);
+        float item_inner_spacing = 4.0f;
+    };
+
+    struct Stats {
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+    };
+
+    static TextMeasureCache& instance();
+
+    TextMeasureCache(const TextMeasureCache&) = delete;
+    TextMeasureCache& operator=(const TextMeasureCache&) = delete;
+
+    /**
+     * @brief Snapshots the current ImGui metrics; call on the UI thread between windows
+     *
+     * Marks the calling thread as the one allowed to measure with ImGui.
+     * The metrics generation moves when the font or any metric changes by
+     * at least one device pixel.
+     */
+    void capture_metrics();
+    Metrics get_metrics() const;
+    std::uint32_t get_metrics_generation() const;
+
+    /**
+     * @brief Logical extent of `text` at the current font size times `text_scale`
+     */
+    ImVec2 measure(std::string_view text, float text_scale);
+
+    // Estimates handed out on the calling thread so far
+    static std::size_t thread_estimate_count();
+
+    std::size_t get_budget() const;
+    void set_budget(std::size_t bytes);
+    void clear();
+    Stats get_stats() const;
+
+private:
+    struct Entry {
+        const ImFont* font;
+        float size;  // pixels
+        std::string text;
+        ImVec2 extent;
+    };
+
+    // Views into the Entry it indexes; list nodes never move
+    struct Key {
+        const ImFont* font;
+        float size;
+        std::string_view text;
+
+        bool operator==(const Key& other) const {
+            return font == other.font && size == other.size && text == other.text;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    TextMeasureCache() = default;
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  // most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    std::size_t bytes_ = 0;
+    std::size_t budget_ = 256 * 1024;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+
+    Metrics metrics_;
+    float global_scale_ = 1.0f;  // ImGuiIO::FontGlobalScale, for pixel sizes
+    std::uint32_t metrics_generation_ = 0;
+    const ImFont* font_ = nullptr;
+    std::thread::id ui_thread_;
+
+    static std::size_t entry_bytes(const Entry& entry) { return sizeof(Entry) + sizeof(Key) + entry.text.size(); }
+    void evict_to_budget();
+};
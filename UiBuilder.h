@@ -1,10 +1,13 @@
 #pragma once
 
+#include "TableWidget.h"
 #include "Widget.h"
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 /**
  * @brief CRTP base providing fluent setters for widget properties and style
@@ -50,46 +53,71 @@ public:
         return self();
     }
 
-    Derived& justify(const std::string& value) {
+    Derived& justify(Widget::Justify value) {
         if (widget_) widget_->get_style().justify = value;
         return self();
     }
 
-    Derived& align(const std::string& value) {
+    Derived& justify(std::string_view value) {
+        if (widget_) widget_style::parse(value, widget_->get_style().justify);
+        return self();
+    }
+
+    Derived& align(Widget::Align value) {
         if (widget_) widget_->get_style().align = value;
         return self();
     }
 
-    Derived& align_self(const std::string& value) {
+    Derived& align(std::string_view value) {
+        if (widget_) widget_style::parse(value, widget_->get_style().align);
+        return self();
+    }
+
+    Derived& align_self(Widget::Align value) {
         if (widget_) widget_->get_style().align_self = value;
         return self();
     }
 
-    Derived& font_size(const std::string& value) {
+    Derived& align_self(std::string_view value) {
+        if (widget_) widget_style::parse(value, widget_->get_style().align_self);
+        return self();
+    }
+
+    Derived& font_size(Widget::FontSize value) {
         if (widget_) widget_->get_style().font_size = value;
         return self();
     }
 
+    Derived& font_size(std::string_view value) {
+        if (widget_) widget_style::parse(value, widget_->get_style().font_size);
+        return self();
+    }
+
     Derived& bold(bool value) {
         if (widget_) widget_->get_style().bold = value;
         return self();
     }
 
-    Derived& text_color(const std::string& value) {
-        if (widget_) widget_->get_style().text_color = value;
+    Derived& text_color(std::string_view value) {
+        if (widget_) widget_style::parse_color(value, widget_->get_style().text_color);
         return self();
     }
 
-    Derived& background_color(const std::string& value) {
-        if (widget_) widget_->get_style().bg_color = value;
+    Derived& background_color(std::string_view value) {
+        if (widget_) widget_style::parse_color(value, widget_->get_style().bg_color);
         return self();
     }
 
-    Derived& variant(const std::string& value) {
+    Derived& variant(Widget::Variant value) {
         if (widget_) widget_->get_style().variant = value;
         return self();
     }
 
+    Derived& variant(std::string_view value) {
+        if (widget_) widget_style::parse(value, widget_->get_style().variant);
+        return self();
+    }
+
     Derived& disabled(bool value) {
         if (widget_) widget_->get_style().disabled = value;
         return self();
@@ -228,3 +256,56 @@ public:
         return self();
     }
 };
+
+/**
+ * @brief Builds a virtualized table over a std::vector of rows
+ *
+ * Columns are member pointers of the row type, so cells address the vector
+ * directly. The vector must outlive the table; it may grow or shrink freely.
+ */
+template <typename Row>
+class TableBuilder : public WidgetBuilderBase<TableBuilder<Row>, TableWidget> {
+public:
+    TableBuilder(const std::string& id, std::vector<Row>* rows)
+        : WidgetBuilderBase<TableBuilder<Row>, TableWidget>(std::make_unique<TableWidget>(id)), rows_(rows) {
+        if (this->widget()) {
+            this->widget()->set_row_count([rows]() { return rows->size(); });
+        }
+    }
+
+    template <typename T>
+    TableBuilder& column(const std::string& header, T Row::* member, float weight = 1.0f) {
+        return add(header, TableColumn::Kind::Input, member, weight, {});
+    }
+
+    template <typename T>
+    TableBuilder& label_column(const std::string& header, T Row::* member, float weight = 1.0f) {
+        return add(header, TableColumn::Kind::Label, member, weight, {});
+    }
+
+    TableBuilder& choice_column(const std::string& header, int Row::* member, std::vector<TableChoice> choices,
+                                float weight = 1.0f) {
+        return add(header, TableColumn::Kind::Choice, member, weight, std::move(choices));
+    }
+
+private:
+    std::vector<Row>* rows_;
+
+    template <typename T>
+    TableBuilder& add(const std::string& header, TableColumn::Kind kind, T Row::* member, float weight,
+                      std::vector<TableChoice> choices) {
+        if (this->widget()) {
+            TableColumn column;
+            column.header = header;
+            column.kind = kind;
+            column.type = binding_type_of<T>();
+            column.weight = weight;
+            column.choices = std::move(choices);
+            column.access = [rows = rows_, member](std::size_t row) -> void* {
+                return row < rows->size() ? &((*rows)[row].*member) : nullptr;
+            };
+            this->widget()->add_column(std::move(column));
+        }
+        return this->self();
+    }
+};
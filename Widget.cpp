@@ -1,65 +1,508 @@
 #include "Widget.h"
+#include "TextMeasureCache.h"
+#include "WidgetArena.h"
+#include "WidgetIndex.h"
 #include <iostream>
 #include <algorithm>
-#include <cstring>
 #include <string>
 #include <cmath>
+#include <new>
 
 namespace {
 
-ImVec4 color_from_name(const std::string& name, const ImVec4& fallback = ImVec4(1.0f, 1.0f, 1.0f, 1.0f)) {
-    if (name == "red") return ImVec4(1.0f, 0.0f, 0.0f, 1.0f);
-    if (name == "green") return ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
-    if (name == "blue") return ImVec4(0.0f, 0.0f, 1.0f, 1.0f);
-    if (name == "yellow") return ImVec4(1.0f, 1.0f, 0.0f, 1.0f);
-    if (name == "gray") return ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
-    if (name == "white") return ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
-    if (name == "black") return ImVec4(0.0f, 0.0f, 0.0f, 1.0f);
-    if (name == "header_bg") return ImVec4(0.16f, 0.35f, 0.60f, 1.0f);
-    if (name == "header_text") return ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
-    return fallback;
+// Ahead of each widget: the arena it was allocated from, or nullptr for the heap
+constexpr std::size_t kAllocationHeader = alignof(std::max_align_t);
+
+constexpr ImU32 kWhite = IM_COL32(255, 255, 255, 255);
+constexpr ImU32 kHeaderBackground = IM_COL32(41, 89, 153, 255);
+constexpr ImU32 kHeaderText = kWhite;
+
+struct NamedColor {
+    std::string_view name;
+    ImU32 color;
+};
+
+constexpr NamedColor kNamedColors[] = {
+    {"red", IM_COL32(255, 0, 0, 255)},
+    {"green", IM_COL32(0, 255, 0, 255)},
+    {"blue", IM_COL32(0, 0, 255, 255)},
+    {"yellow", IM_COL32(255, 255, 0, 255)},
+    {"gray", IM_COL32(128, 128, 128, 255)},
+    {"white", kWhite},
+    {"black", IM_COL32(0, 0, 0, 255)},
+    {"header_bg", kHeaderBackground},
+    {"header_text", kHeaderText},
+};
+
+YGJustify to_yoga(Widget::Justify justify) {
+    switch (justify) {
+    case Widget::Justify::Center:       return YGJustifyCenter;
+    case Widget::Justify::FlexEnd:      return YGJustifyFlexEnd;
+    case Widget::Justify::SpaceBetween: return YGJustifySpaceBetween;
+    case Widget::Justify::SpaceAround:  return YGJustifySpaceAround;
+    case Widget::Justify::SpaceEvenly:  return YGJustifySpaceEvenly;
+    case Widget::Justify::FlexStart:    break;
+    }
+    return YGJustifyFlexStart;
+}
+
+YGAlign to_yoga(Widget::Align align) {
+    switch (align) {
+    case Widget::Align::FlexStart: return YGAlignFlexStart;
+    case Widget::Align::Center:    return YGAlignCenter;
+    case Widget::Align::FlexEnd:   return YGAlignFlexEnd;
+    case Widget::Align::Stretch:   return YGAlignStretch;
+    case Widget::Align::Baseline:  return YGAlignBaseline;
+    case Widget::Align::Auto:      break;
+    }
+    return YGAlignAuto;
+}
+
+// align-items has no "auto"; containers stretch their children by default
+YGAlign to_yoga_items(Widget::Align align) {
+    return align == Widget::Align::Auto ? YGAlignStretch : to_yoga(align);
+}
+
+// Dimensions default to YGUndefined (NaN), which never compares equal to itself
+bool same_dimension(float a, float b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+// Natural width of text fields, in font heights
+constexpr float kInputWidthEms = 12.0f;
+
+// Clamps a measured extent to Yoga's constraint on that axis
+float constrain(float measured, float limit, YGMeasureMode mode) {
+    switch (mode) {
+    case YGMeasureModeExactly:   return limit;
+    case YGMeasureModeAtMost:    return std::min(measured, limit);
+    case YGMeasureModeUndefined: break;
+    }
+    return measured;
+}
+
+float frame_height(const TextMeasureCache::Metrics& metrics) {
+    return metrics.font_size + metrics.frame_padding.y * 2.0f;
+}
+
+// ImGui hides everything from "##" on
+std::string_view visible_text(const std::string& label) {
+    return std::string_view(label).substr(0, label.find("##"));
+}
+
+// Checkboxes and radio buttons: a frame-high square, then the text
+ImVec2 measure_toggle(const std::string& text) {
+    TextMeasureCache& cache = TextMeasureCache::instance();
+    TextMeasureCache::Metrics metrics = cache.get_metrics();
+    ImVec2 extent = cache.measure(visible_text(text), 1.0f);
+    float square = frame_height(metrics);
+    float width = extent.x > 0.0f ? square + metrics.item_inner_spacing + extent.x : square;
+    return ImVec2(width, std::max(square, extent.y + metrics.frame_padding.y * 2.0f));
+}
+
+// Grows the bound string when ImGui needs room for more text
+int resize_string(ImGuiInputTextCallbackData* data) {
+    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize) {
+        auto* text = static_cast<std::string*>(data->UserData);
+        text->resize(static_cast<std::size_t>(data->BufTextLen));
+        data->Buf = text->data();
+    }
+    return 0;
 }
 
 } // namespace
 
+// ============================================================================
+// Style Names
+// ============================================================================
+
+namespace widget_style {
+
+bool parse(std::string_view value, Widget::Justify& out) {
+    using Justify = Widget::Justify;
+    if (value == "flex-start") { out = Justify::FlexStart; return true; }
+    if (value == "center") { out = Justify::Center; return true; }
+    if (value == "flex-end") { out = Justify::FlexEnd; return true; }
+    if (value == "space-between") { out = Justify::SpaceBetween; return true; }
+    if (value == "space-around") { out = Justify::SpaceAround; return true; }
+    if (value == "space-evenly") { out = Justify::SpaceEvenly; return true; }
+    return false;
+}
+
+bool parse(std::string_view value, Widget::Align& out) {
+    using Align = Widget::Align;
+    if (value == "auto") { out = Align::Auto; return true; }
+    if (value == "flex-start") { out = Align::FlexStart; return true; }
+    if (value == "center") { out = Align::Center; return true; }
+    if (value == "flex-end") { out = Align::FlexEnd; return true; }
+    if (value == "stretch") { out = Align::Stretch; return true; }
+    if (value == "baseline") { out = Align::Baseline; return true; }
+    return false;
+}
+
+bool parse(std::string_view value, Widget::Variant& out) {
+    using Variant = Widget::Variant;
+    if (value == "default") { out = Variant::Default; return true; }
+    if (value == "primary") { out = Variant::Primary; return true; }
+    if (value == "danger") { out = Variant::Danger; return true; }
+    if (value == "header") { out = Variant::Header; return true; }
+    return false;
+}
+
+bool parse(std::string_view value, Widget::FontSize& out) {
+    using FontSize = Widget::FontSize;
+    if (value == "default") { out = FontSize::Default; return true; }
+    if (value == "small") { out = FontSize::Small; return true; }
+    if (value == "large") { out = FontSize::Large; return true; }
+    return false;
+}
+
+bool parse_color(std::string_view value, ImU32& out) {
+    if (value == "default") {
+        out = Widget::kDefaultColor;
+        return true;
+    }
+    for (const auto& named : kNamedColors) {
+        if (named.name == value) {
+            out = named.color;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace widget_style
+
+// ============================================================================
+// String Input
+// ============================================================================
+
+namespace widget_input {
+
+bool input_text(const char* label, std::string& text, ImGuiInputTextFlags flags) {
+    // capacity() + 1 counts the terminator std::string always keeps
+    return ImGui::InputText(label, text.data(), text.capacity() + 1, flags | ImGuiInputTextFlags_CallbackResize,
+                            resize_string, &text);
+}
+
+} // namespace widget_input
+
+// ============================================================================
+// Leaf Drawing
+// ============================================================================
+
+namespace widget_draw {
+
+void label(std::string_view text, const Widget::Style& style, float text_scale) {
+    ImGui::SetWindowFontScale(text_scale);
+    ImGui::PushStyleColor(ImGuiCol_Text, style.text_color != Widget::kDefaultColor ? style.text_color : kWhite);
+    ImGui::TextUnformatted(text.data(), text.data() + text.size());
+    ImGui::PopStyleColor();
+    ImGui::SetWindowFontScale(1.0f);
+}
+
+void input_text(const char* label, std::string* value, const Widget::Style& style, const Widget::LayoutBox& box) {
+    if (!value) {
+        return;
+    }
+    if (box.width > 0) {
+        ImGui::SetNextItemWidth(box.width);
+    }
+    if (style.disabled) {
+        ImGui::BeginDisabled();
+    }
+    
+    // Edits land directly in the bound string
+    widget_input::input_text(label, *value);
+    
+    if (style.disabled) {
+        ImGui::EndDisabled();
+    }
+}
+
+void input_number(const char* label, float* float_value, int* int_value, const Widget::Style& style,
+                  const Widget::LayoutBox& box) {
+    if (box.width > 0) {
+        ImGui::SetNextItemWidth(box.width);
+    }
+    if (style.disabled) {
+        ImGui::BeginDisabled();
+    }
+    
+    if (float_value) {
+        ImGui::InputFloat(label, float_value);
+    } else if (int_value) {
+        ImGui::InputInt(label, int_value);
+    }
+    
+    if (style.disabled) {
+        ImGui::EndDisabled();
+    }
+}
+
+void checkbox(const char* label, bool* value, const Widget::Style& style) {
+    if (style.disabled) {
+        ImGui::BeginDisabled();
+    }
+    if (value) {
+        ImGui::Checkbox(label, value);
+    }
+    if (style.disabled) {
+        ImGui::EndDisabled();
+    }
+}
+
+void radio_button(const char* label, int* selected, int value, const Widget::Style& style) {
+    if (style.disabled) {
+        ImGui::BeginDisabled();
+    }
+    if (selected) {
+        if (ImGui::RadioButton(label, *selected == value)) {
+            *selected = value;
+        }
+    }
+    if (style.disabled) {
+        ImGui::EndDisabled();
+    }
+}
+
+void button(const char* label, const Widget::Style& style, const Widget::LayoutBox& box, float text_scale,
+            const std::function<void()>* callback) {
+    ImVec2 button_size(box.width > 0.0f ? box.width : 0.0f, box.height > 0 ? box.height : 0);
+    
+    if (style.disabled) {
+        ImGui::BeginDisabled();
+    }
+    
+    // Apply button variant styling
+    int colors_pushed = 0;
+    int text_color_pushed = 0;
+    int style_vars_pushed = 0;
+    int border_color_pushed = 0;
+
+    ImU32 text_color = style.text_color;
+    if (style.variant == Widget::Variant::Primary) {
+        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.0f, 0.5f, 1.0f, 1.0f));
+        ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.0f, 0.6f, 1.0f, 1.0f));
+        ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.0f, 0.45f, 0.9f, 1.0f));
+        colors_pushed = 3;
+    } else if (style.variant == Widget::Variant::Danger) {
+        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f));
+        ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.9f, 0.3f, 0.3f, 1.0f));
+        ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.7f, 0.15f, 0.15f, 1.0f));
+        colors_pushed = 3;
+    } else if (style.variant == Widget::Variant::Header) {
+        ImGui::PushStyleColor(ImGuiCol_Button, kHeaderBackground);
+        ImGui::PushStyleColor(ImGuiCol_ButtonHovered, kHeaderBackground);
+        ImGui::PushStyleColor(ImGuiCol_ButtonActive, kHeaderBackground);
+        colors_pushed = 3;
+        if (text_color == Widget::kDefaultColor) {
+            text_color = kHeaderText;
+        }
+        ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(1.0f, 1.0f, 1.0f, 0.35f));
+        border_color_pushed = 1;
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.0f);
+        style_vars_pushed++;
+    }
+
+    if (text_color != Widget::kDefaultColor) {
+        ImGui::PushStyleColor(ImGuiCol_Text, text_color);
+        text_color_pushed++;
+    }
+
+    if (style.padding > 0.0f) {
+        float style_scale = ImGui::GetIO().FontGlobalScale;
+        if (style_scale <= 0.0f) {
+            style_scale = 1.0f;
+        }
+        float pad = style.padding * style_scale;
+        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(pad, pad * 0.75f));
+        style_vars_pushed++;
+    }
+
+    bool font_scaled = std::abs(text_scale - 1.0f) > 0.01f;
+    if (font_scaled) {
+        ImGui::SetWindowFontScale(text_scale);
+    }
+    
+    if (ImGui::Button(label, button_size)) {
+        if (callback && *callback) {
+            (*callback)();
+        }
+    }
+    
+    if (font_scaled) {
+        ImGui::SetWindowFontScale(1.0f);
+    }
+
+    while (style_vars_pushed-- > 0) {
+        ImGui::PopStyleVar();
+    }
+
+    if (text_color_pushed > 0) {
+        ImGui::PopStyleColor(text_color_pushed);
+    }
+
+    if (border_color_pushed > 0) {
+        ImGui::PopStyleColor(border_color_pushed);
+    }
+
+    if (colors_pushed > 0) {
+        ImGui::PopStyleColor(colors_pushed);
+    }
+    
+    if (style.disabled) {
+        ImGui::EndDisabled();
+    }
+}
+
+} // namespace widget_draw
+
 // ============================================================================
 // Base Widget Implementation
 // ============================================================================
 
-Widget::Widget(const std::string& id) : id_(id) {
+void* Widget::operator new(std::size_t size) {
+    WidgetArena* arena = WidgetArena::current();
+    void* memory = arena ? arena->allocate(size + kAllocationHeader, alignof(std::max_align_t))
+                         : ::operator new(size + kAllocationHeader);
+    new (memory) WidgetArena*(arena);
+    return static_cast<std::byte*>(memory) + kAllocationHeader;
+}
+
+void Widget::operator delete(void* memory) {
+    if (!memory) {
+        return;
+    }
+    std::byte* block = static_cast<std::byte*>(memory) - kAllocationHeader;
+    // Arena memory is freed with the arena's blocks; this only drops the reference
+    if (WidgetArena* arena = *std::launder(reinterpret_cast<WidgetArena**>(block))) {
+        arena->deallocate();
+    } else {
+        ::operator delete(block);
+    }
+}
+
+Widget::Widget(WidgetKind kind, const std::string& id) : kind_(kind), id_(id) {
     yoga_node_ = YGNodeNew();
+    Widget::update_label();
 }
 
 Widget::~Widget() {
+    if (widget_index_) {
+        widget_index_->erase(*this);
+    }
     if (yoga_node_) {
         YGNodeFree(yoga_node_);
     }
 }
 
+void Widget::set_id(const std::string& id) {
+    if (id == id_) {
+        return;
+    }
+    if (widget_index_) {
+        widget_index_->erase(*this);
+    }
+    id_ = id;
+    if (widget_index_) {
+        widget_index_->insert(*this);
+    }
+    update_label();
+}
+
+void Widget::notify_changed() {
+    if (widget_index_) {
+        widget_index_->touch();
+    }
+}
+
+void Widget::set_widget_index(WidgetIndex* index) {
+    if (widget_index_) {
+        widget_index_->erase(*this);
+    }
+    widget_index_ = index;
+    if (widget_index_) {
+        widget_index_->insert(*this);
+    }
+}
+
+void Widget::update_label() {
+    label_ = "##" + id_;
+}
+
+void Widget::enable_measure() {
+    if (yoga_node_) {
+        YGNodeSetContext(yoga_node_, this);
+        YGNodeSetMeasureFunc(yoga_node_, &Widget::measure_node);
+    }
+}
+
+void Widget::mark_measure_dirty() {
+    // Yoga only lets measured leaves be marked dirty by hand
+    if (yoga_node_ && YGNodeHasMeasureFunc(yoga_node_)) {
+        YGNodeMarkDirty(yoga_node_);
+    }
+}
+
+YGSize Widget::measure_node(YGNodeConstRef node, float width, YGMeasureMode width_mode,
+                            float height, YGMeasureMode height_mode) {
+    const auto* widget = static_cast<const Widget*>(YGNodeGetContext(node));
+    ImVec2 size = widget ? widget->measure_content() : ImVec2(0.0f, 0.0f);
+    return YGSize{constrain(size.x, width, width_mode), constrain(size.y, height, height_mode)};
+}
+
+YGConfigRef Widget::get_yoga_config() const {
+    // Yoga hands the config back const; nodes only ever share a panel's own config
+    return yoga_node_ ? const_cast<YGConfigRef>(YGNodeGetConfig(yoga_node_)) : nullptr;
+}
+
+void Widget::set_yoga_config(YGConfigRef config) {
+    if (yoga_node_ && config) {
+        YGNodeSetConfig(yoga_node_, config);
+    }
+}
+
 void Widget::update_layout(float available_width, float available_height) {
     if (yoga_node_) {
-        apply_styles();
         YGNodeCalculateLayout(yoga_node_, available_width, available_height, YGDirectionLTR);
     }
 }
 
 void Widget::set_width(float width) {
+    if (same_dimension(width_, width)) {
+        return;
+    }
     width_ = width;
-    if (yoga_node_ && width != YGUndefined) {
-        YGNodeStyleSetWidth(yoga_node_, width);
+    if (yoga_node_) {
+        if (!std::isnan(width)) {
+            YGNodeStyleSetWidth(yoga_node_, width);
+        } else {
+            YGNodeStyleSetWidthAuto(yoga_node_);
+        }
     }
 }
 
 void Widget::set_height(float height) {
+    if (same_dimension(height_, height)) {
+        return;
+    }
     height_ = height;
-    if (yoga_node_ && height != YGUndefined) {
-        YGNodeStyleSetHeight(yoga_node_, height);
+    if (yoga_node_) {
+        if (!std::isnan(height)) {
+            YGNodeStyleSetHeight(yoga_node_, height);
+        } else {
+            YGNodeStyleSetHeightAuto(yoga_node_);
+        }
     }
 }
 
 void Widget::set_flex(float flex) {
+    if (same_dimension(flex_, flex)) {
+        return;
+    }
     flex_ = flex;
-    if (yoga_node_ && flex != YGUndefined) {
+    if (yoga_node_) {
         YGNodeStyleSetFlex(yoga_node_, flex);
     }
 }
@@ -67,28 +510,20 @@ void Widget::set_flex(float flex) {
 void Widget::apply_styles() {
     if (!yoga_node_) return;
     
-    float scale = ImGui::GetIO().FontGlobalScale;
-    if (scale <= 0.0f) {
-        scale = 1.0f;
-    }
-
-    float margin = style_.margin * scale;
-    float padding = style_.padding * scale;
-
-    YGNodeStyleSetMargin(yoga_node_, YGEdgeAll, margin);
-    YGNodeStyleSetPadding(yoga_node_, YGEdgeAll, padding);
+    // Logical units; the panel's Yoga config and readback apply the DPI scale
+    YGNodeStyleSetMargin(yoga_node_, YGEdgeAll, style_.margin);
+    YGNodeStyleSetPadding(yoga_node_, YGEdgeAll, style_.padding);
     
-    // Apply spacing
     // Apply align-self for individual items
-    if (style_.align_self != "auto") {
-        if (style_.align_self == "center") {
-            YGNodeStyleSetAlignSelf(yoga_node_, YGAlignCenter);
-        } else if (style_.align_self == "flex-start") {
-            YGNodeStyleSetAlignSelf(yoga_node_, YGAlignFlexStart);
-        } else if (style_.align_self == "flex-end") {
-            YGNodeStyleSetAlignSelf(yoga_node_, YGAlignFlexEnd);
-        } else if (style_.align_self == "stretch") {
-            YGNodeStyleSetAlignSelf(yoga_node_, YGAlignStretch);
+    YGNodeStyleSetAlignSelf(yoga_node_, to_yoga(style_.align_self));
+    
+    // Only re-measure when something measure_content() reads has changed
+    if (yoga_node_ && YGNodeHasMeasureFunc(yoga_node_)) {
+        MeasureInputs inputs{TextMeasureCache::instance().get_metrics_generation(), style_.padding, style_.font_size,
+                             style_.bold};
+        if (!(inputs == measure_inputs_)) {
+            measure_inputs_ = inputs;
+            mark_measure_dirty();
         }
     }
 }
@@ -98,18 +533,81 @@ void Widget::setup_yoga_layout() {
     apply_styles();
 }
 
+void Widget::set_style(const Style& style) {
+    if (!(style_ == style)) {
+        style_ = style;
+        style_dirty_ = true;
+        notify_changed();
+    }
+}
+
+void Widget::sync_styles(std::uint32_t generation) {
+    // A style edit may touch container-only values, so redo the full setup;
+    // a scale change only rescales the spacing
+    if (style_dirty_) {
+        setup_yoga_layout();
+    } else if (generation != style_generation_) {
+        apply_styles();
+    }
+    style_dirty_ = false;
+    style_generation_ = generation;
+}
+
+void Widget::copy_layout_from(const Widget& source) {
+    width_ = source.width_;
+    height_ = source.height_;
+    flex_ = source.flex_;
+    style_ = source.style_;
+    style_dirty_ = source.style_dirty_;
+    style_generation_ = source.style_generation_;
+    if (yoga_node_ && source.yoga_node_) {
+        YGNodeCopyStyle(yoga_node_, source.yoga_node_);
+    }
+}
+
+bool Widget::patch_from(const Widget& source) {
+    bool changed = false;
+    
+    // Yoga only marks the node dirty when a style value actually changes
+    if (!same_dimension(width_, source.width_)) {
+        set_width(source.width_);
+        changed = true;
+    }
+    if (!same_dimension(height_, source.height_)) {
+        set_height(source.height_);
+        changed = true;
+    }
+    if (!same_dimension(flex_, source.flex_)) {
+        set_flex(source.flex_);
+        changed = true;
+    }
+    if (!(style_ == source.style_)) {
+        style_ = source.style_;
+        setup_yoga_layout();
+        changed = true;
+    }
+    
+    // Derived overrides notify again for their own fields; only real changes count
+    if (changed) {
+        notify_changed();
+    }
+    return changed;
+}
+
 // ============================================================================
 // Container Widget Implementation
 // ============================================================================
 
-ContainerWidget::ContainerWidget(const std::string& id) : Widget(id) {}
+ContainerWidget::ContainerWidget(WidgetKind kind, const std::string& id) : Widget(kind, id) {}
 
 void ContainerWidget::add_child(std::unique_ptr<Widget> child) {
     if (!child) return;
     
     if (yoga_node_ && child->get_yoga_node()) {
+        child->set_yoga_config(get_yoga_config());
         YGNodeInsertChild(yoga_node_, child->get_yoga_node(), children_.size());
     }
+    child->set_widget_index(get_widget_index());
     
     children_.push_back(std::move(child));
 }
@@ -124,10 +622,60 @@ void ContainerWidget::remove_child(const std::string& id) {
         if (yoga_node_ && (*it)->get_yoga_node()) {
             YGNodeRemoveChild(yoga_node_, (*it)->get_yoga_node());
         }
+        (*it)->set_widget_index(nullptr);
         children_.erase(it);
     }
 }
 
+void ContainerWidget::clone_children_from(const ContainerWidget& source) {
+    children_.reserve(source.children_.size());
+    for (const auto& child : source.children_) {
+        add_child(child->clone());
+    }
+}
+
+bool ContainerWidget::render_children_positioned(bool scope_ids) {
+    const RenderRegion* region = get_render_region();
+    if (!region) {
+        return false;
+    }
+    
+    // Clip rect in layout coordinates
+    float clip_left = region->clip_min.x - region->origin.x;
+    float clip_top = region->clip_min.y - region->origin.y;
+    float clip_right = region->clip_max.x - region->origin.x;
+    float clip_bottom = region->clip_max.y - region->origin.y;
+    
+    bool column = yoga_node_ && YGNodeStyleGetFlexDirection(yoga_node_) == YGFlexDirectionColumn;
+    auto first = children_.begin();
+    if (column) {
+        first = std::partition_point(children_.begin(), children_.end(), [clip_top](const auto& child) {
+            return child->get_layout().top + child->get_layout().height < clip_top;
+        });
+    }
+    
+    for (auto it = first; it != children_.end(); ++it) {
+        const LayoutBox& box = (*it)->get_layout();
+        if (column && box.top > clip_bottom) {
+            break;
+        }
+        if (box.top + box.height < clip_top || box.top > clip_bottom ||
+            box.left + box.width < clip_left || box.left > clip_right) {
+            continue;
+        }
+        
+        ImGui::SetCursorScreenPos(ImVec2(region->origin.x + box.left, region->origin.y + box.top));
+        if (scope_ids) {
+            ImGui::PushID(static_cast<int>(it - children_.begin()));
+        }
+        (*it)->render();
+        if (scope_ids) {
+            ImGui::PopID();
+        }
+    }
+    return true;
+}
+
 Widget* ContainerWidget::find_child(const std::string& id) {
     auto it = std::find_if(children_.begin(), children_.end(),
         [&id](const std::unique_ptr<Widget>& widget) {
@@ -142,34 +690,44 @@ void ContainerWidget::apply_styles() {
     if (!get_yoga_node()) {
         return;
     }
+    YGNodeStyleSetGap(get_yoga_node(), YGGutterAll, style_.gap);
+}
 
-    float scale = ImGui::GetIO().FontGlobalScale;
-    if (scale <= 0.0f) {
-        scale = 1.0f;
+void ContainerWidget::set_yoga_config(YGConfigRef config) {
+    Widget::set_yoga_config(config);
+    for (auto& child : children_) {
+        child->set_yoga_config(config);
     }
-    YGNodeStyleSetGap(get_yoga_node(), YGGutterAll, style_.gap * scale);
 }
 
-void ContainerWidget::update_layout(float available_width, float available_height) {
-    Widget::update_layout(available_width, available_height);
-    
-    // Update children layouts
+void ContainerWidget::set_widget_index(WidgetIndex* index) {
+    Widget::set_widget_index(index);
+    for (auto& child : children_) {
+        child->set_widget_index(index);
+    }
+}
+
+void ContainerWidget::sync_styles(std::uint32_t generation) {
+    Widget::sync_styles(generation);
     for (auto& child : children_) {
-        float child_width = YGNodeLayoutGetWidth(child->get_yoga_node());
-        float child_height = YGNodeLayoutGetHeight(child->get_yoga_node());
-        child->update_layout(child_width, child_height);
+        child->sync_styles(generation);
     }
 }
 
+
 // ============================================================================
 // Layout Widget Implementations
 // ============================================================================
 
-HLayoutWidget::HLayoutWidget(const std::string& id) : ContainerWidget(id) {
+HLayoutWidget::HLayoutWidget(const std::string& id) : ContainerWidget(kKind, id) {
     setup_yoga_layout();
 }
 
 void HLayoutWidget::render() {
+    if (render_children_positioned()) {
+        return;
+    }
+    
     // Render children horizontally
     for (size_t i = 0; i < children_.size(); i++) {
         if (i > 0) ImGui::SameLine();
@@ -181,48 +739,25 @@ void HLayoutWidget::setup_yoga_layout() {
     if (yoga_node_) {
         YGNodeStyleSetFlexDirection(yoga_node_, YGFlexDirectionRow);
         YGNodeStyleSetAlignItems(yoga_node_, YGAlignCenter);
-        float scale = ImGui::GetIO().FontGlobalScale;
-        if (scale <= 0.0f) {
-            scale = 1.0f;
-        }
-        YGNodeStyleSetGap(yoga_node_, YGGutterAll, style_.gap * scale);
+        YGNodeStyleSetGap(yoga_node_, YGGutterAll, style_.gap);
         
         // Apply container-specific alignment
-        if (style_.justify == "center") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifyCenter);
-        } else if (style_.justify == "flex-end") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifyFlexEnd);
-        } else if (style_.justify == "space-between") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifySpaceBetween);
-        } else if (style_.justify == "space-around") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifySpaceAround);
-        } else if (style_.justify == "space-evenly") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifySpaceEvenly);
-        } else {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifyFlexStart);
-        }
-        
-        if (style_.align == "center") {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignCenter);
-        } else if (style_.align == "flex-start") {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignFlexStart);
-        } else if (style_.align == "flex-end") {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignFlexEnd);
-        } else if (style_.align == "baseline") {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignBaseline);
-        } else {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignStretch);
-        }
+        YGNodeStyleSetJustifyContent(yoga_node_, to_yoga(style_.justify));
+        YGNodeStyleSetAlignItems(yoga_node_, to_yoga_items(style_.align));
     }
     
     ContainerWidget::apply_styles();
 }
 
-VLayoutWidget::VLayoutWidget(const std::string& id) : ContainerWidget(id) {
+VLayoutWidget::VLayoutWidget(const std::string& id) : ContainerWidget(kKind, id) {
     setup_yoga_layout();
 }
 
 void VLayoutWidget::render() {
+    if (render_children_positioned()) {
+        return;
+    }
+    
     // Render children vertically (natural ImGui flow)
     for (auto& child : children_) {
         child->render();
@@ -232,38 +767,11 @@ void VLayoutWidget::render() {
 void VLayoutWidget::setup_yoga_layout() {
     if (yoga_node_) {
         YGNodeStyleSetFlexDirection(yoga_node_, YGFlexDirectionColumn);
-        float scale = ImGui::GetIO().FontGlobalScale;
-        if (scale <= 0.0f) {
-            scale = 1.0f;
-        }
-        YGNodeStyleSetGap(yoga_node_, YGGutterAll, style_.gap * scale);
+        YGNodeStyleSetGap(yoga_node_, YGGutterAll, style_.gap);
         
         // Apply same alignment logic as HLayout but for column direction
-        if (style_.justify == "center") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifyCenter);
-        } else if (style_.justify == "flex-end") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifyFlexEnd);
-        } else if (style_.justify == "space-between") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifySpaceBetween);
-        } else if (style_.justify == "space-around") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifySpaceAround);
-        } else if (style_.justify == "space-evenly") {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifySpaceEvenly);
-        } else {
-            YGNodeStyleSetJustifyContent(yoga_node_, YGJustifyFlexStart);
-        }
-        
-        if (style_.align == "center") {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignCenter);
-        } else if (style_.align == "flex-start") {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignFlexStart);
-        } else if (style_.align == "flex-end") {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignFlexEnd);
-        } else if (style_.align == "baseline") {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignBaseline);
-        } else {
-            YGNodeStyleSetAlignItems(yoga_node_, YGAlignStretch);
-        }
+        YGNodeStyleSetJustifyContent(yoga_node_, to_yoga(style_.justify));
+        YGNodeStyleSetAlignItems(yoga_node_, to_yoga_items(style_.align));
     }
     
     ContainerWidget::apply_styles();
@@ -274,261 +782,300 @@ void VLayoutWidget::setup_yoga_layout() {
 // ============================================================================
 
 LabelWidget::LabelWidget(const std::string& id, const std::string& text) 
-    : Widget(id), text_(text) {
+    : Widget(kKind, id), text_(text) {
+    enable_measure();
     setup_yoga_layout();
 }
 
-void LabelWidget::render() {
-    apply_styles();
-    
-    // Apply ImGui font scaling based on style
+float LabelWidget::text_scale() const {
     float font_scale = 1.0f;
-    if (style_.font_size == "small") {
+    if (style_.font_size == FontSize::Small) {
         font_scale = 0.9f;
-    } else if (style_.font_size == "large") {
+    } else if (style_.font_size == FontSize::Large) {
         font_scale = 1.2f;
     }
     if (style_.bold) {
         font_scale += 0.1f;
     }
-    ImGui::SetWindowFontScale(font_scale);
-    
-    // Apply text color
-    ImVec4 text_color = color_from_name(style_.text_color, ImVec4(1.0f, 1.0f, 1.0f, 1.0f));
-    
-    ImGui::PushStyleColor(ImGuiCol_Text, text_color);
-    
-    ImGui::TextUnformatted(text_.c_str());
-    
-    ImGui::PopStyleColor();
-    
-    // Reset font scale
-    ImGui::SetWindowFontScale(1.0f);
+    return font_scale;
+}
+
+ImVec2 LabelWidget::measure_content() const {
+    return TextMeasureCache::instance().measure(text_, text_scale());
+}
+
+void LabelWidget::render() {
+    widget_draw::label(text_, style_, text_scale());
 }
 
 InputTextWidget::InputTextWidget(const std::string& id, std::string* value) 
-    : Widget(id), value_(value) {
+    : Widget(kKind, id), value_(value) {
+    enable_measure();
     setup_yoga_layout();
 }
 
 void InputTextWidget::render() {
-    apply_styles();
-    
-    if (value_) {
-        strncpy(buffer_, value_->c_str(), sizeof(buffer_) - 1);
-        buffer_[sizeof(buffer_) - 1] = '\0';
-        
-        float w = YGNodeLayoutGetWidth(yoga_node_);
-        if (w > 0) {
-            ImGui::SetNextItemWidth(w);
-        }
-        
-        if (style_.disabled) {
-            ImGui::BeginDisabled();
-        }
-        
-        if (ImGui::InputText(("##" + id_).c_str(), buffer_, sizeof(buffer_))) {
-            *value_ = buffer_;
-        }
-        
-        if (style_.disabled) {
-            ImGui::EndDisabled();
-        }
-    }
+    widget_draw::input_text(label_.c_str(), value_, style_, layout_);
 }
 
-InputNumberWidget::InputNumberWidget(const std::string& id) : Widget(id) {
+ImVec2 InputTextWidget::measure_content() const {
+    TextMeasureCache::Metrics metrics = TextMeasureCache::instance().get_metrics();
+    return ImVec2(metrics.font_size * kInputWidthEms, frame_height(metrics));
+}
+
+InputNumberWidget::InputNumberWidget(const std::string& id) : Widget(kKind, id) {
+    enable_measure();
     setup_yoga_layout();
 }
 
 void InputNumberWidget::render() {
-    apply_styles();
-    
-    float w = YGNodeLayoutGetWidth(yoga_node_);
-    if (w > 0) {
-        ImGui::SetNextItemWidth(w);
-    }
-    
-    if (style_.disabled) {
-        ImGui::BeginDisabled();
-    }
-    
-    if (float_value_) {
-        ImGui::InputFloat(("##" + id_).c_str(), float_value_);
-    } else if (int_value_) {
-        ImGui::InputInt(("##" + id_).c_str(), int_value_);
-    }
-    
-    if (style_.disabled) {
-        ImGui::EndDisabled();
-    }
+    widget_draw::input_number(label_.c_str(), float_value_, int_value_, style_, layout_);
+}
+
+ImVec2 InputNumberWidget::measure_content() const {
+    TextMeasureCache::Metrics metrics = TextMeasureCache::instance().get_metrics();
+    return ImVec2(metrics.font_size * kInputWidthEms, frame_height(metrics));
 }
 
 CheckboxWidget::CheckboxWidget(const std::string& id, const std::string& text, bool* value)
-    : Widget(id), text_(text), value_(value) {
+    : Widget(kKind, id), text_(text), value_(value) {
+    enable_measure();
     setup_yoga_layout();
 }
 
 void CheckboxWidget::render() {
-    apply_styles();
-    
-    if (style_.disabled) {
-        ImGui::BeginDisabled();
-    }
-    
-    if (value_) {
-        ImGui::Checkbox(text_.c_str(), value_);
-    }
-    
-    if (style_.disabled) {
-        ImGui::EndDisabled();
-    }
+    widget_draw::checkbox(text_.c_str(), value_, style_);
+}
+
+ImVec2 CheckboxWidget::measure_content() const {
+    return measure_toggle(text_);
 }
 
 RadioButtonWidget::RadioButtonWidget(const std::string& id, const std::string& text, 
                                      const std::string& group, int value, int* selected)
-    : Widget(id), text_(text), group_(group), value_(value), selected_(selected) {
+    : Widget(kKind, id), text_(text), group_(group), value_(value), selected_(selected) {
+    update_label();
+    enable_measure();
     setup_yoga_layout();
 }
 
-void RadioButtonWidget::render() {
-    apply_styles();
-    
-    if (style_.disabled) {
-        ImGui::BeginDisabled();
-    }
-    
-    if (selected_) {
-        bool is_selected = (*selected_ == value_);
-        std::string label = text_;
-        if (!id_.empty()) {
-            label += "##" + id_;
-        }
-        if (ImGui::RadioButton(label.c_str(), is_selected)) {
-            *selected_ = value_;
-        }
-    }
-    
-    if (style_.disabled) {
-        ImGui::EndDisabled();
+void RadioButtonWidget::update_label() {
+    label_ = text_;
+    if (!id_.empty()) {
+        label_ += "##";
+        label_ += id_;
     }
 }
 
+ImVec2 RadioButtonWidget::measure_content() const {
+    return measure_toggle(text_);
+}
+
+void RadioButtonWidget::render() {
+    widget_draw::radio_button(label_.c_str(), selected_, value_, style_);
+}
+
 ButtonWidget::ButtonWidget(const std::string& id, const std::string& text)
-    : Widget(id), text_(text) {
+    : Widget(kKind, id), text_(text) {
+    update_label();
+    enable_measure();
     setup_yoga_layout();
 }
 
-void ButtonWidget::render() {
-    apply_styles();
-    
-    float w = YGNodeLayoutGetWidth(yoga_node_);
-    float h = YGNodeLayoutGetHeight(yoga_node_);
-    float computed_width = (w > 0.0f) ? w : 0.0f;
-    ImVec2 button_size(computed_width, h > 0 ? h : 0);
-    
-    if (style_.disabled) {
-        ImGui::BeginDisabled();
+void ButtonWidget::update_label() {
+    label_ = text_;
+    if (!id_.empty()) {
+        label_ += "##";
+        label_ += id_;
     }
-    
-    // Apply button variant styling
-    int colors_pushed = 0;
-    int text_color_pushed = 0;
-    int style_vars_pushed = 0;
-    int border_color_pushed = 0;
+}
 
-    ImGuiStyle& imgui_style = ImGui::GetStyle();
-    ImVec4 effective_text_color = imgui_style.Colors[ImGuiCol_Text];
-    if (style_.text_color != "default") {
-        effective_text_color = color_from_name(style_.text_color, effective_text_color);
+float ButtonWidget::text_scale() const {
+    float font_scale = 1.0f;
+    if (style_.font_size == FontSize::Small) {
+        font_scale = 0.9f;
+    } else if (style_.font_size == FontSize::Large) {
+        font_scale = 1.1f;
     }
-    if (style_.variant == "primary") {
-        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.0f, 0.5f, 1.0f, 1.0f));
-        ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.0f, 0.6f, 1.0f, 1.0f));
-        ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.0f, 0.45f, 0.9f, 1.0f));
-        colors_pushed = 3;
-    } else if (style_.variant == "danger") {
-        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f));
-        ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.9f, 0.3f, 0.3f, 1.0f));
-        ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.7f, 0.15f, 0.15f, 1.0f));
-        colors_pushed = 3;
-    } else if (style_.variant == "header") {
-        ImVec4 header_color = color_from_name("header_bg", ImVec4(0.16f, 0.35f, 0.60f, 1.0f));
-        ImGui::PushStyleColor(ImGuiCol_Button, header_color);
-        ImGui::PushStyleColor(ImGuiCol_ButtonHovered, header_color);
-        ImGui::PushStyleColor(ImGuiCol_ButtonActive, header_color);
-        colors_pushed = 3;
-        if (style_.text_color == "default") {
-            effective_text_color = color_from_name("header_text", ImVec4(1.0f, 1.0f, 1.0f, 1.0f));
-        }
-        ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(1.0f, 1.0f, 1.0f, 0.35f));
-        border_color_pushed = 1;
-        ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.0f);
-        style_vars_pushed++;
+    if (style_.bold) {
+        font_scale += 0.1f;
     }
+    return font_scale;
+}
 
-    if (style_.variant == "header" || style_.text_color != "default") {
-        ImGui::PushStyleColor(ImGuiCol_Text, effective_text_color);
-        text_color_pushed++;
+ImVec2 ButtonWidget::measure_content() const {
+    TextMeasureCache& cache = TextMeasureCache::instance();
+    TextMeasureCache::Metrics metrics = cache.get_metrics();
+    ImVec2 extent = cache.measure(visible_text(text_), text_scale());
+    
+    // Same frame padding render() pushes, in logical units
+    ImVec2 padding = metrics.frame_padding;
+    if (style_.padding > 0.0f) {
+        padding = ImVec2(style_.padding, style_.padding * 0.75f);
     }
+    return ImVec2(extent.x + padding.x * 2.0f, extent.y + padding.y * 2.0f);
+}
 
-    if (style_.padding > 0.0f) {
-        float style_scale = ImGui::GetIO().FontGlobalScale;
-        if (style_scale <= 0.0f) {
-            style_scale = 1.0f;
-        }
-        float pad = style_.padding * style_scale;
-        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(pad, pad * 0.75f));
-        style_vars_pushed++;
+void ButtonWidget::render() {
+    widget_draw::button(label_.c_str(), style_, layout_, text_scale(), &callback_);
+}
+
+// ============================================================================
+// Hot Reload Patching
+// ============================================================================
+
+bool LabelWidget::patch_from(const Widget& source) {
+    bool changed = Widget::patch_from(source);
+    const auto& label = static_cast<const LabelWidget&>(source);
+    if (text_ != label.text_) {
+        text_ = label.text_;
+        mark_measure_dirty();
+        changed = true;
+    }
+    if (changed) {
+        notify_changed();
     }
+    return changed;
+}
 
-    float font_scale = 1.0f;
-    if (style_.font_size == "small") {
-        font_scale = 0.9f;
-    } else if (style_.font_size == "large") {
-        font_scale = 1.1f;
+bool InputTextWidget::patch_from(const Widget& source) {
+    bool changed = Widget::patch_from(source);
+    const auto& input = static_cast<const InputTextWidget&>(source);
+    if (value_ != input.value_) {
+        value_ = input.value_;
+        changed = true;
     }
-    if (style_.bold) {
-        font_scale += 0.1f;
+    if (changed) {
+        notify_changed();
     }
-    bool font_scaled = std::abs(font_scale - 1.0f) > 0.01f;
-    if (font_scaled) {
-        ImGui::SetWindowFontScale(font_scale);
+    return changed;
+}
+
+bool InputNumberWidget::patch_from(const Widget& source) {
+    bool changed = Widget::patch_from(source);
+    const auto& input = static_cast<const InputNumberWidget&>(source);
+    if (float_value_ != input.float_value_ || int_value_ != input.int_value_) {
+        float_value_ = input.float_value_;
+        int_value_ = input.int_value_;
+        changed = true;
     }
-    
-    std::string label = text_;
-    if (!id_.empty()) {
-        label += "##" + id_;
+    if (changed) {
+        notify_changed();
     }
-    if (ImGui::Button(label.c_str(), button_size)) {
-        if (callback_) {
-            callback_();
+    return changed;
+}
+
+bool CheckboxWidget::patch_from(const Widget& source) {
+    bool changed = Widget::patch_from(source);
+    const auto& checkbox = static_cast<const CheckboxWidget&>(source);
+    if (text_ != checkbox.text_ || value_ != checkbox.value_) {
+        if (text_ != checkbox.text_) {
+            text_ = checkbox.text_;
+            mark_measure_dirty();
         }
+        value_ = checkbox.value_;
+        changed = true;
     }
-    
-    if (font_scaled) {
-        ImGui::SetWindowFontScale(1.0f);
+    if (changed) {
+        notify_changed();
     }
+    return changed;
+}
 
-    while (style_vars_pushed-- > 0) {
-        ImGui::PopStyleVar();
+bool RadioButtonWidget::patch_from(const Widget& source) {
+    bool changed = Widget::patch_from(source);
+    const auto& radio = static_cast<const RadioButtonWidget&>(source);
+    // Only the text feeds the label and the measured size
+    if (text_ != radio.text_) {
+        text_ = radio.text_;
+        update_label();
+        mark_measure_dirty();
+        changed = true;
     }
-
-    if (text_color_pushed > 0) {
-        ImGui::PopStyleColor(text_color_pushed);
+    if (group_ != radio.group_ || value_ != radio.value_ || selected_ != radio.selected_) {
+        group_ = radio.group_;
+        value_ = radio.value_;
+        selected_ = radio.selected_;
+        changed = true;
     }
-
-    if (border_color_pushed > 0) {
-        ImGui::PopStyleColor(border_color_pushed);
+    if (changed) {
+        notify_changed();
     }
+    return changed;
+}
 
-    if (colors_pushed > 0) {
-        ImGui::PopStyleColor(colors_pushed);
+bool ButtonWidget::patch_from(const Widget& source) {
+    bool changed = Widget::patch_from(source);
+    const auto& button = static_cast<const ButtonWidget&>(source);
+    if (text_ != button.text_) {
+        text_ = button.text_;
+        update_label();
+        mark_measure_dirty();
+        changed = true;
     }
-    
-    if (style_.disabled) {
-        ImGui::EndDisabled();
+    // Callbacks can't be compared; always take the current registration
+    callback_ = button.callback_;
+    if (changed) {
+        notify_changed();
     }
+    return changed;
+}
+
+// ============================================================================
+// Cloning
+// ============================================================================
+
+std::unique_ptr<Widget> HLayoutWidget::clone() const {
+    auto copy = std::make_unique<HLayoutWidget>(id_);
+    copy->copy_layout_from(*this);
+    copy->clone_children_from(*this);
+    return copy;
+}
+
+std::unique_ptr<Widget> VLayoutWidget::clone() const {
+    auto copy = std::make_unique<VLayoutWidget>(id_);
+    copy->copy_layout_from(*this);
+    copy->clone_children_from(*this);
+    return copy;
+}
+
+std::unique_ptr<Widget> LabelWidget::clone() const {
+    auto copy = std::make_unique<LabelWidget>(id_, text_);
+    copy->copy_layout_from(*this);
+    return copy;
+}
+
+std::unique_ptr<Widget> InputTextWidget::clone() const {
+    auto copy = std::make_unique<InputTextWidget>(id_, value_);
+    copy->copy_layout_from(*this);
+    return copy;
+}
+
+std::unique_ptr<Widget> InputNumberWidget::clone() const {
+    auto copy = std::make_unique<InputNumberWidget>(id_);
+    copy->float_value_ = float_value_;
+    copy->int_value_ = int_value_;
+    copy->copy_layout_from(*this);
+    return copy;
+}
+
+std::unique_ptr<Widget> CheckboxWidget::clone() const {
+    auto copy = std::make_unique<CheckboxWidget>(id_, text_, value_);
+    copy->copy_layout_from(*this);
+    return copy;
+}
+
+std::unique_ptr<Widget> RadioButtonWidget::clone() const {
+    auto copy = std::make_unique<RadioButtonWidget>(id_, text_, group_, value_, selected_);
+    copy->copy_layout_from(*this);
+    return copy;
+}
+
+std::unique_ptr<Widget> ButtonWidget::clone() const {
+    auto copy = std::make_unique<ButtonWidget>(id_, text_);
+    copy->callback_ = callback_;
+    copy->copy_layout_from(*this);
+    return copy;
 }
 
 // ============================================================================
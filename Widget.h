@@ -1,13 +1,42 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <type_traits>
 #include "imgui.h"
 #include "yoga/Yoga.h"
 
 // Forward declarations
 class AppData;
+class PanelReconciler;
+class WidgetIndex;
+
+/**
+ * @brief Concrete type of a widget, stored in every Widget
+ *
+ * Lets typed lookups and tree walks test a byte instead of going through
+ * RTTI; see widget_cast.
+ */
+enum class WidgetKind : std::uint8_t {
+    Label,
+    InputText,
+    InputNumber,
+    Checkbox,
+    RadioButton,
+    Button,
+    Table,
+    HLayout,
+    VLayout,
+    Repeat,
+};
+
+constexpr bool is_container_kind(WidgetKind kind) {
+    return kind == WidgetKind::HLayout || kind == WidgetKind::VLayout || kind == WidgetKind::Repeat;
+}
 
 /**
  * @brief Base class for all UI widgets
@@ -20,14 +49,47 @@ class Widget {
 public:
     virtual ~Widget();
     
+    // From the calling thread's WidgetArena scope if one is open, else the heap
+    static void* operator new(std::size_t size);
+    static void operator delete(void* memory);
+    
     // Core interface
     virtual void render() = 0;
+    // Lays out the whole subtree rooted here with one YGNodeCalculateLayout call
     virtual void update_layout(float available_width, float available_height);
     virtual bool accepts_children() const { return false; }
     
+    // Computed layout, read back from Yoga once per layout pass by Panel;
+    // left/top are relative to the panel's root widget
+    struct LayoutBox {
+        float left = 0.0f;
+        float top = 0.0f;
+        float width = 0.0f;
+        float height = 0.0f;
+    };
+    const LayoutBox& get_layout() const { return layout_; }
+    
+    /**
+     * @brief Screen-space frame for positioned rendering
+     * 
+     * While a panel renders in positioned mode, containers place each child
+     * at `origin` plus its layout box and skip children whose box lies
+     * outside the clip rect. Without a region, widgets follow ImGui flow.
+     */
+    struct RenderRegion {
+        ImVec2 origin;
+        ImVec2 clip_min;
+        ImVec2 clip_max;
+    };
+    static const RenderRegion* get_render_region() { return render_region_; }
+    static void set_render_region(const RenderRegion* region) { render_region_ = region; }
+    
     // Property accessors
+    WidgetKind get_kind() const { return kind_; }
+    bool is_container() const { return is_container_kind(kind_); }
+    
     const std::string& get_id() const { return id_; }
-    void set_id(const std::string& id) { id_ = id; }
+    void set_id(const std::string& id);
     
     float get_width() const { return width_; }
     void set_width(float width);
@@ -38,50 +100,203 @@ public:
     float get_flex() const { return flex_; }
     void set_flex(float flex);
     
+    // Style values, resolved from their XML/builder names by widget_style::parse
+    enum class Justify : std::uint8_t { FlexStart, Center, FlexEnd, SpaceBetween, SpaceAround, SpaceEvenly };
+    enum class Align : std::uint8_t { Auto, FlexStart, Center, FlexEnd, Stretch, Baseline };
+    enum class Variant : std::uint8_t { Default, Primary, Danger, Header };
+    enum class FontSize : std::uint8_t { Default, Small, Large };
+    
+    // Packed colors; kDefaultColor keeps the widget's own color
+    static constexpr ImU32 kDefaultColor = 0;
+    
     // Style properties
     struct Style {
         float margin = 0.0f;
         float padding = 0.0f;
         float gap = 8.0f;
         
-        std::string justify = "flex-start";
-        std::string align = "stretch";
-        std::string align_self = "auto";
+        ImU32 text_color = kDefaultColor;
+        ImU32 bg_color = kDefaultColor;
         
-        bool disabled = false;
-        std::string variant = "default";
+        Justify justify = Justify::FlexStart;
+        Align align = Align::Stretch;
+        Align align_self = Align::Auto;
+        Variant variant = Variant::Default;
+        FontSize font_size = FontSize::Default;
         
-        std::string font_size = "default";
-        bool bold = false;
+        bool disabled : 1 = false;
+        bool bold : 1 = false;
+        bool stretch : 1 = false;
+        bool wrap : 1 = false;
         
-        std::string text_color = "default";
-        std::string bg_color = "default";
-        
-        bool stretch = false;
-        bool wrap = false;
+        bool operator==(const Style& other) const = default;
     };
     
-    Style& get_style() { return style_; }
+    // Mutable access marks the style dirty; edits reach Yoga on the next
+    // sync_styles(), i.e. the panel's next layout pass
+    Style& get_style() { style_dirty_ = true; notify_changed(); return style_; }
     const Style& get_style() const { return style_; }
+    void set_style(const Style& style);
     
     // Layout management
     YGNodeRef get_yoga_node() const { return yoga_node_; }
     
+    // Yoga config of the subtree; a panel sets its own on the whole tree and
+    // children take their parent's when added
+    YGConfigRef get_yoga_config() const;
+    virtual void set_yoga_config(YGConfigRef config);
+    
+    // Panel index the subtree is registered in; set the same way as the config
+    WidgetIndex* get_widget_index() const { return widget_index_; }
+    virtual void set_widget_index(WidgetIndex* index);
+    
     // Style and layout application
     virtual void apply_styles();
     virtual void setup_yoga_layout();
     
-protected:
-    Widget(const std::string& id = "");
+    /**
+     * @brief Pushes the style into Yoga if it changed since the last sync
+     * 
+     * `generation` is the owning panel's style generation, bumped when
+     * ImGui's font or style metrics change so measured widgets re-measure
+     * once. Otherwise a clean widget makes no Yoga calls. Styles are in
+     * logical units, so a DPI change does not restyle anything, and
+     * apply_styles() only dirties a measured leaf when its font, bold,
+     * padding or the text metrics actually moved.
+     */
+    virtual void sync_styles(std::uint32_t generation);
+    
+    /**
+     * @brief Copies properties and bindings from a freshly parsed widget
+     * 
+     * Used by hot reload to update a live widget in place, keeping its Yoga
+     * node and any UI state. `source` must have the same dynamic type.
+     * Children are not touched. Returns true if anything changed.
+     */
+    virtual bool patch_from(const Widget& source);
+    
+    /**
+     * @brief Deep copy with its own Yoga node; used to stamp template rows
+     */
+    virtual std::unique_ptr<Widget> clone() const = 0;
     
+protected:
+    friend class Panel;
+    friend class WidgetStore;
+    
+    Widget(WidgetKind kind, const std::string& id = "");
+    
+    // Copies geometry and style, including the Yoga style, from a widget of the same type
+    void copy_layout_from(const Widget& source);
+    
+    /**
+     * @brief Rebuilds label_ from the id (and text, for widgets that show one)
+     * 
+     * Labels are composed here, when the id or text changes, so render()
+     * passes a ready string to ImGui instead of concatenating every frame.
+     */
+    virtual void update_label();
+    
+    /**
+     * @brief Natural size of the widget's content, asked for by Yoga
+     * 
+     * Only called for widgets that called enable_measure(): leaves sized by
+     * their text or ImGui frame. Yoga clamps the result to its constraints
+     * and caches it until mark_measure_dirty(). Called during layout, which
+     * may run on a worker thread, so measure through TextMeasureCache.
+     */
+    virtual ImVec2 measure_content() const { return ImVec2(0.0f, 0.0f); }
+    
+    // Font scale the widget's text renders at, relative to the window font
+    virtual float text_scale() const { return 1.0f; }
+    
+    void enable_measure();
+    void mark_measure_dirty();
+    
+    // Tells the panel's index that something a tree snapshot copies has changed
+    void notify_changed();
+    
+    const WidgetKind kind_;
     std::string id_;
+    std::string label_;  // ImGui label, "##<id>" unless update_label is overridden
     float width_ = YGUndefined;
     float height_ = YGUndefined;
     float flex_ = YGUndefined;
     Style style_;
+    bool style_dirty_ = true;
+    std::uint32_t style_generation_ = 0;
+    LayoutBox layout_;
     YGNodeRef yoga_node_ = nullptr;
+    
+private:
+    static inline const RenderRegion* render_region_ = nullptr;  // UI thread only
+    WidgetIndex* widget_index_ = nullptr;
+    
+    // What a measured leaf's size depended on when apply_styles() last marked it dirty
+    struct MeasureInputs {
+        std::uint32_t metrics_generation = 0;  // TextMeasureCache's
+        float padding = 0.0f;
+        FontSize font_size = FontSize::Default;
+        bool bold = false;
+        
+        bool operator==(const MeasureInputs& other) const = default;
+    };
+    MeasureInputs measure_inputs_;
+    
+    static YGSize measure_node(YGNodeConstRef node, float width, YGMeasureMode width_mode,
+                               float height, YGMeasureMode height_mode);
 };
 
+/**
+ * @brief Style value names as written in XML and builder calls
+ *
+ * Each parse() maps a name (`"space-between"`, `"primary"`, `"red"`) to its
+ * compiled value and returns false, leaving `out` untouched, for unknown
+ * names. Rendering only ever sees the compiled values.
+ */
+namespace widget_style {
+
+bool parse(std::string_view value, Widget::Justify& out);
+bool parse(std::string_view value, Widget::Align& out);
+bool parse(std::string_view value, Widget::Variant& out);
+bool parse(std::string_view value, Widget::FontSize& out);
+bool parse_color(std::string_view value, ImU32& out);
+
+} // namespace widget_style
+
+namespace widget_input {
+
+/**
+ * @brief ImGui::InputText editing a std::string in place
+ *
+ * ImGui writes straight into the string's storage and grows it through
+ * ImGuiInputTextFlags_CallbackResize, so there is no intermediate buffer,
+ * no per-frame copy and no length limit.
+ */
+bool input_text(const char* label, std::string& text, ImGuiInputTextFlags flags = 0);
+
+} // namespace widget_input
+
+/**
+ * @brief Draw code of the leaf widgets, shared by every storage backend
+ *
+ * Each function draws one widget from its style, layout box and bound
+ * values. The widget classes' render() and Panel's data-oriented
+ * WidgetStore both call these, so the two backends look the same.
+ */
+namespace widget_draw {
+
+void label(std::string_view text, const Widget::Style& style, float text_scale);
+void input_text(const char* label, std::string* value, const Widget::Style& style, const Widget::LayoutBox& box);
+void input_number(const char* label, float* float_value, int* int_value, const Widget::Style& style,
+                  const Widget::LayoutBox& box);
+void checkbox(const char* label, bool* value, const Widget::Style& style);
+void radio_button(const char* label, int* selected, int value, const Widget::Style& style);
+void button(const char* label, const Widget::Style& style, const Widget::LayoutBox& box, float text_scale,
+            const std::function<void()>* callback);
+
+} // namespace widget_draw
+
 /**
  * @brief Container widget that can hold child widgets
  * 
@@ -98,13 +313,41 @@ public:
     void remove_child(const std::string& id);
     Widget* find_child(const std::string& id);
     const std::vector<std::unique_ptr<Widget>>& get_children() const { return children_; }
+    void reserve_children(std::size_t count) { children_.reserve(count); }
     
     bool accepts_children() const override { return true; }
     void apply_styles() override;
-    void update_layout(float available_width, float available_height) override;
+    void sync_styles(std::uint32_t generation) override;
+    void set_yoga_config(YGConfigRef config) override;
+    void set_widget_index(WidgetIndex* index) override;
+    
+    /**
+     * @brief Brings the children up to date with bound data before layout
+     * 
+     * Containers whose children follow data (RepeatWidget's rows) override
+     * this. Panel::render calls it ahead of its layout check, so changed
+     * children are laid out and drawn in the same frame. Returns true if the
+     * children changed.
+     */
+    virtual bool sync_children() { return false; }
 
 protected:
-    ContainerWidget(const std::string& id = "");
+    friend class PanelReconciler;
+    
+    ContainerWidget(WidgetKind kind, const std::string& id = "");
+    
+    void clone_children_from(const ContainerWidget& source);
+    
+    /**
+     * @brief Renders visible children at their layout positions
+     * 
+     * Children of a column are sorted by their boxes, so the first visible
+     * one is found by binary search and the walk stops past the clip rect;
+     * cost follows the visible rows, not the child count.
+     * @param scope_ids Push each child's index as an ImGui ID
+     * @return false if no render region is set; the caller renders in flow order
+     */
+    bool render_children_positioned(bool scope_ids = false);
     
     std::vector<std::unique_ptr<Widget>> children_;
 };
@@ -114,8 +357,11 @@ protected:
  */
 class HLayoutWidget : public ContainerWidget {
 public:
+    static constexpr WidgetKind kKind = WidgetKind::HLayout;
+    
     explicit HLayoutWidget(const std::string& id = "");
     void render() override;
+    std::unique_ptr<Widget> clone() const override;
 
 protected:
     void setup_yoga_layout() override;
@@ -126,8 +372,11 @@ protected:
  */
 class VLayoutWidget : public ContainerWidget {
 public:
+    static constexpr WidgetKind kKind = WidgetKind::VLayout;
+    
     explicit VLayoutWidget(const std::string& id = "");
     void render() override;
+    std::unique_ptr<Widget> clone() const override;
 
 protected:
     void setup_yoga_layout() override;
@@ -138,12 +387,25 @@ protected:
  */
 class LabelWidget : public Widget {
 public:
+    static constexpr WidgetKind kKind = WidgetKind::Label;
+    
     explicit LabelWidget(const std::string& id = "", const std::string& text = "");
     
     void render() override;
+    bool patch_from(const Widget& source) override;
+    std::unique_ptr<Widget> clone() const override;
     
     const std::string& get_text() const { return text_; }
-    void set_text(const std::string& text) { text_ = text; }
+    void set_text(const std::string& text) {
+        if (text == text_) return;
+        text_ = text;
+        mark_measure_dirty();
+        notify_changed();
+    }
+
+protected:
+    ImVec2 measure_content() const override;
+    float text_scale() const override;
 
 private:
     std::string text_;
@@ -154,16 +416,26 @@ private:
  */
 class InputTextWidget : public Widget {
 public:
+    static constexpr WidgetKind kKind = WidgetKind::InputText;
+    
     explicit InputTextWidget(const std::string& id = "", std::string* value = nullptr);
     
     void render() override;
-    
-    void bind_value(std::string* value) { value_ = value; }
+    bool patch_from(const Widget& source) override;
+    std::unique_ptr<Widget> clone() const override;
+    
+    void bind_value(std::string* value) {
+        if (value == value_) return;
+        value_ = value;
+        notify_changed();
+    }
     std::string* get_value() const { return value_; }
 
+protected:
+    ImVec2 measure_content() const override;
+
 private:
     std::string* value_ = nullptr;
-    char buffer_[256] = {0};
 };
 
 /**
@@ -171,16 +443,33 @@ private:
  */
 class InputNumberWidget : public Widget {
 public:
+    static constexpr WidgetKind kKind = WidgetKind::InputNumber;
+    
     explicit InputNumberWidget(const std::string& id = "");
     
     void render() override;
-    
-    void bind_float_value(float* value) { float_value_ = value; int_value_ = nullptr; }
-    void bind_int_value(int* value) { int_value_ = value; float_value_ = nullptr; }
+    bool patch_from(const Widget& source) override;
+    std::unique_ptr<Widget> clone() const override;
+    
+    void bind_float_value(float* value) {
+        if (value == float_value_ && !int_value_) return;
+        float_value_ = value;
+        int_value_ = nullptr;
+        notify_changed();
+    }
+    void bind_int_value(int* value) {
+        if (value == int_value_ && !float_value_) return;
+        int_value_ = value;
+        float_value_ = nullptr;
+        notify_changed();
+    }
     
     float* get_float_value() const { return float_value_; }
     int* get_int_value() const { return int_value_; }
 
+protected:
+    ImVec2 measure_content() const override;
+
 private:
     float* float_value_ = nullptr;
     int* int_value_ = nullptr;
@@ -191,16 +480,32 @@ private:
  */
 class CheckboxWidget : public Widget {
 public:
+    static constexpr WidgetKind kKind = WidgetKind::Checkbox;
+    
     explicit CheckboxWidget(const std::string& id = "", const std::string& text = "", bool* value = nullptr);
     
     void render() override;
+    bool patch_from(const Widget& source) override;
+    std::unique_ptr<Widget> clone() const override;
     
     const std::string& get_text() const { return text_; }
-    void set_text(const std::string& text) { text_ = text; }
-    
-    void bind_value(bool* value) { value_ = value; }
+    void set_text(const std::string& text) {
+        if (text == text_) return;
+        text_ = text;
+        mark_measure_dirty();
+        notify_changed();
+    }
+    
+    void bind_value(bool* value) {
+        if (value == value_) return;
+        value_ = value;
+        notify_changed();
+    }
     bool* get_value() const { return value_; }
 
+protected:
+    ImVec2 measure_content() const override;
+
 private:
     std::string text_;
     bool* value_ = nullptr;
@@ -211,23 +516,49 @@ private:
  */
 class RadioButtonWidget : public Widget {
 public:
+    static constexpr WidgetKind kKind = WidgetKind::RadioButton;
+    
     explicit RadioButtonWidget(const std::string& id = "", const std::string& text = "", 
                               const std::string& group = "", int value = 0, int* selected = nullptr);
     
     void render() override;
+    bool patch_from(const Widget& source) override;
+    std::unique_ptr<Widget> clone() const override;
     
     const std::string& get_text() const { return text_; }
-    void set_text(const std::string& text) { text_ = text; }
+    void set_text(const std::string& text) {
+        if (text == text_) return;
+        text_ = text;
+        update_label();
+        mark_measure_dirty();
+        notify_changed();
+    }
     
     const std::string& get_group() const { return group_; }
-    void set_group(const std::string& group) { group_ = group; }
+    void set_group(const std::string& group) {
+        if (group == group_) return;
+        group_ = group;
+        notify_changed();
+    }
     
     int get_value() const { return value_; }
-    void set_value(int value) { value_ = value; }
-    
-    void bind_selected(int* selected) { selected_ = selected; }
+    void set_value(int value) {
+        if (value == value_) return;
+        value_ = value;
+        notify_changed();
+    }
+    
+    void bind_selected(int* selected) {
+        if (selected == selected_) return;
+        selected_ = selected;
+        notify_changed();
+    }
     int* get_selected() const { return selected_; }
 
+protected:
+    void update_label() override;
+    ImVec2 measure_content() const override;
+
 private:
     std::string text_;
     std::string group_;
@@ -240,20 +571,78 @@ private:
  */
 class ButtonWidget : public Widget {
 public:
+    static constexpr WidgetKind kKind = WidgetKind::Button;
+    
     explicit ButtonWidget(const std::string& id = "", const std::string& text = "");
     
     void render() override;
+    bool patch_from(const Widget& source) override;
+    std::unique_ptr<Widget> clone() const override;
     
     const std::string& get_text() const { return text_; }
-    void set_text(const std::string& text) { text_ = text; }
-    
-    void set_callback(std::function<void()> callback) { callback_ = callback; }
+    void set_text(const std::string& text) {
+        if (text == text_) return;
+        text_ = text;
+        update_label();
+        mark_measure_dirty();
+        notify_changed();
+    }
+    
+    // Snapshots hold a pointer to callback_, so a new callback needs no notification
+    void set_callback(std::function<void()> callback) { callback_ = std::move(callback); }
+    const std::function<void()>& get_callback() const { return callback_; }
+
+protected:
+    void update_label() override;
+    ImVec2 measure_content() const override;
+    float text_scale() const override;
 
 private:
     std::string text_;
     std::function<void()> callback_;
 };
 
+/**
+ * @brief Checked downcast by kind tag, without RTTI
+ * 
+ * T is Widget, ContainerWidget or a concrete widget with a `kKind`.
+ * Returns nullptr if `widget` is null or of another kind.
+ */
+template<typename T>
+T* widget_cast(Widget* widget) {
+    if constexpr (std::is_same_v<T, Widget>) {
+        return widget;
+    } else if constexpr (std::is_same_v<T, ContainerWidget>) {
+        return widget && widget->is_container() ? static_cast<ContainerWidget*>(widget) : nullptr;
+    } else {
+        return widget && widget->get_kind() == T::kKind ? static_cast<T*>(widget) : nullptr;
+    }
+}
+
+template<typename T>
+const T* widget_cast(const Widget* widget) {
+    return widget_cast<T>(const_cast<Widget*>(widget));
+}
+
+/**
+ * @brief Pre-order walk of a widget tree with static dispatch
+ * 
+ * `visit` is called with each widget and returns false to skip that
+ * widget's children. The visitor is a template parameter, so its calls
+ * inline, and containers are found by their kind tag rather than RTTI.
+ */
+template<typename WidgetT, typename Visit>
+void walk_widgets(WidgetT& widget, Visit&& visit) {
+    if (!visit(widget)) {
+        return;
+    }
+    if (auto* container = widget_cast<ContainerWidget>(&widget)) {
+        for (const auto& child : container->get_children()) {
+            walk_widgets(*child, visit);
+        }
+    }
+}
+
 /**
  * @brief Widget factory for creating widgets from strings
  * 
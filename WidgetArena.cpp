@@ -0,0 +1,73 @@
+#include "WidgetArena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+thread_local WidgetArena* t_current_arena = nullptr;
+
+} // namespace
+
+// ============================================================================
+// WidgetArena Implementation
+// ============================================================================
+
+WidgetArena::Handle WidgetArena::create(std::size_t block_size) {
+    return Handle(new WidgetArena(std::max<std::size_t>(block_size, 1024)));
+}
+
+WidgetArena* WidgetArena::current() {
+    return t_current_arena;
+}
+
+void* WidgetArena::allocate(std::size_t size, std::size_t alignment) {
+    auto align_up = [alignment](std::byte* pointer) {
+        auto address = reinterpret_cast<std::uintptr_t>(pointer);
+        return reinterpret_cast<std::byte*>((address + alignment - 1) & ~(alignment - 1));
+    };
+
+    std::byte* memory = cursor_ ? align_up(cursor_) : nullptr;
+    if (!memory || memory + size > end_) {
+        if (size + alignment > block_size_ / 4) {
+            // Large requests get a block of their own; the current block stays open
+            memory = align_up(add_block(size + alignment));
+        } else {
+            cursor_ = add_block(block_size_);
+            end_ = cursor_ + block_size_;
+            memory = align_up(cursor_);
+            cursor_ = memory + size;
+        }
+    } else {
+        cursor_ = memory + size;
+    }
+
+    stats_.used += size;
+    ++stats_.allocations;
+    references_.fetch_add(1, std::memory_order_relaxed);
+    return memory;
+}
+
+std::byte* WidgetArena::add_block(std::size_t size) {
+    blocks_.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+    ++stats_.blocks;
+    stats_.reserved += size;
+    return blocks_.back().get();
+}
+
+void WidgetArena::release() {
+    if (references_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+// ============================================================================
+// Scope
+// ============================================================================
+
+WidgetArena::Scope::Scope(WidgetArena* arena) : previous_(t_current_arena) {
+    t_current_arena = arena;
+}
+
+WidgetArena::Scope::~Scope() {
+    t_current_arena = previous_;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Monotonic memory for the widgets of one panel
+ *
+ * While a WidgetArena::Scope is open on a thread, widgets created on that
+ * thread (Widget's class operator new) are bump-allocated from the arena
+ * instead of the heap, so a panel's widgets sit next to each other in
+ * build order and building them costs a pointer bump each. Deleting such
+ * a widget runs its destructor as usual but gives no memory back; the
+ * arena's blocks are freed together once the owner and every widget
+ * allocated from it are gone.
+ *
+ * The arena is reference counted: the owner's Handle holds one reference
+ * and each live widget another, so a panel may be destroyed on any thread.
+ * Widgets should not outlive their panel: hot reload copies the subtrees
+ * it adopts onto the heap rather than keeping a whole parsed arena alive.
+ *
+ * Only the widget objects themselves live here. Each widget still owns
+ * heap strings and a Yoga node (Yoga has no node allocator hook), and
+ * teardown still runs every destructor: YGNodeFree, the string frees and
+ * the index erase. What the arena saves is one malloc and one free per
+ * widget, plus the locality of the widget objects; it is not a bulk
+ * release of everything a panel allocates.
+ *
+ * Allocation is not synchronized: only one thread at a time may have a
+ * scope open on a given arena. Widgets created with no scope open, such
+ * as repeat rows stamped when a collection grows, come from the heap.
+ */
+class WidgetArena {
+public:
+    static constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+
+    struct Release {
+        void operator()(WidgetArena* arena) const { arena->release(); }
+    };
+    using Handle = std::unique_ptr<WidgetArena, Release>;
+
+    struct Stats {
+        std::size_t blocks = 0;
+        std::size_t reserved = 0;  // bytes in all blocks
+        std::size_t used = 0;      // bytes handed out
+        std::size_t allocations = 0;
+    };
+
+    static Handle create(std::size_t block_size = kDefaultBlockSize);
+
+    WidgetArena(const WidgetArena&) = delete;
+    WidgetArena& operator=(const WidgetArena&) = delete;
+
+    /**
+     * @brief Makes `arena` the calling thread's widget arena until destroyed
+     *
+     * Scopes nest; the previous arena is restored on exit. A null arena
+     * sends allocations back to the heap.
+     */
+    class Scope {
+    public:
+        explicit Scope(WidgetArena* arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        WidgetArena* previous_;
+    };
+
+    // Arena of the innermost open scope on this thread, or nullptr
+    static WidgetArena* current();
+
+    /**
+     * @brief Memory for one object; takes a reference released by deallocate()
+     */
+    void* allocate(std::size_t size, std::size_t alignment);
+    void deallocate() { release(); }
+
+    // Allocation side only; call from the thread that has a scope open
+    Stats get_stats() const { return stats_; }
+
+private:
+    explicit WidgetArena(std::size_t block_size) : block_size_(block_size) {}
+    ~WidgetArena() = default;
+
+    void release();
+    std::byte* add_block(std::size_t size);
+
+    std::size_t block_size_;
+    std::vector<std::unique_ptr<std::byte[]>> blocks_;
+    std::byte* cursor_ = nullptr;
+    std::byte* end_ = nullptr;
+    Stats stats_;
+    std::atomic<std::size_t> references_{1};
+};
@@ -0,0 +1,50 @@
+#include "WidgetIndex.h"
+#include "Widget.h"
+#include <algorithm>
+
+// ============================================================================
+// WidgetIndex Implementation
+// ============================================================================
+
+void WidgetIndex::insert(Widget& widget) {
+    ++version_;
+    if (widget.get_id().empty()) {
+        return;
+    }
+    auto [it, inserted] = widgets_.try_emplace(widget.get_id(), &widget);
+    if (!inserted && it->second != &widget) {
+        shadowed_[it->first].push_back(it->second);
+        it->second = &widget;
+    }
+}
+
+void WidgetIndex::erase(const Widget& widget) {
+    ++version_;
+    auto it = widgets_.find(widget.get_id());
+    if (it == widgets_.end()) {
+        return;
+    }
+    auto shadowed = shadowed_.find(it->first);
+    if (it->second == &widget) {
+        // The most recent widget it shadowed takes the id back
+        if (shadowed == shadowed_.end()) {
+            widgets_.erase(it);
+            return;
+        }
+        it->second = shadowed->second.back();
+        shadowed->second.pop_back();
+    } else if (shadowed != shadowed_.end()) {
+        auto& widgets = shadowed->second;
+        widgets.erase(std::remove(widgets.begin(), widgets.end(), &widget), widgets.end());
+    } else {
+        return;
+    }
+    if (shadowed->second.empty()) {
+        shadowed_.erase(shadowed);
+    }
+}
+
+Widget* WidgetIndex::find(const std::string& id) const {
+    auto it = widgets_.find(id);
+    return it != widgets_.end() ? it->second : nullptr;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Widget;
+
+/**
+ * @brief Id to widget map over one panel's tree
+ *
+ * Widgets register themselves when they join an indexed tree (see
+ * Widget::set_widget_index) and unregister when they leave it, change id
+ * or are destroyed, so find() is a single hash lookup whatever the panel
+ * size. Anonymous widgets are not indexed. Ids are expected to be unique
+ * within a panel; for duplicates, the widget registered last wins, and the
+ * ones it shadows are kept aside so that removing it makes the most recent
+ * remaining one findable again.
+ */
+class WidgetIndex {
+public:
+    void insert(Widget& widget);
+    void erase(const Widget& widget);
+
+    Widget* find(const std::string& id) const;
+    std::size_t size() const { return widgets_.size(); }
+    
+    /**
+     * @brief Moves whenever a widget joins or leaves the tree or reports a change
+     * 
+     * Widgets call touch() (through Widget::notify_changed) when a property
+     * that a snapshot of the tree copies changes, so a WidgetStore can tell
+     * it is stale with one compare.
+     */
+    std::uint64_t get_version() const { return version_; }
+    void touch() { ++version_; }
+
+private:
+    std::unordered_map<std::string, Widget*> widgets_;
+    // Earlier widgets with an id in widgets_, oldest first; empty for unique ids
+    std::unordered_map<std::string, std::vector<Widget*>> shadowed_;
+    std::uint64_t version_ = 0;
+};
@@ -0,0 +1,240 @@
+#include "WidgetStore.h"
+#include <algorithm>
+#include <limits>
+
+// ============================================================================
+// WidgetStore Implementation
+// ============================================================================
+
+void WidgetStore::build(Widget& root) {
+    clear();
+
+    // Breadth first: appending a node's children while walking the array
+    // leaves every sibling group contiguous
+    append(root);
+    for (Index node = 0; node < widgets_.size(); ++node) {
+        auto* container = widget_cast<ContainerWidget>(widgets_[node]);
+        if (!container) {
+            continue;
+        }
+        const auto& children = container->get_children();
+        first_child_[node] = static_cast<Index>(widgets_.size());
+        child_count_[node] = static_cast<Index>(children.size());
+        for (const auto& child : children) {
+            append(*child);
+        }
+    }
+}
+
+void WidgetStore::clear() {
+    kinds_.clear();
+    first_child_.clear();
+    child_count_.clear();
+    sorted_by_top_.clear();
+    styles_.clear();
+    boxes_.clear();
+    text_scales_.clear();
+    labels_.clear();
+    bindings_.clear();
+    text_.clear();
+    widgets_.clear();
+}
+
+void WidgetStore::refresh_layout() {
+    for (std::size_t node = 0; node < widgets_.size(); ++node) {
+        boxes_[node] = widgets_[node]->get_layout();
+    }
+}
+
+void WidgetStore::append(Widget& widget) {
+    WidgetKind kind = widget.get_kind();
+    YGNodeRef yoga_node = widget.get_yoga_node();
+
+    Binding binding;
+    TextRef label;
+    switch (kind) {
+    case WidgetKind::Label:
+        label = add_text(static_cast<LabelWidget&>(widget).get_text());
+        break;
+    case WidgetKind::InputText:
+        binding.value = static_cast<InputTextWidget&>(widget).get_value();
+        label = add_text(widget.label_);
+        break;
+    case WidgetKind::InputNumber: {
+        auto& input = static_cast<InputNumberWidget&>(widget);
+        if (input.get_int_value()) {
+            binding.value = input.get_int_value();
+            binding.extra = 1;
+        } else {
+            binding.value = input.get_float_value();
+        }
+        label = add_text(widget.label_);
+        break;
+    }
+    case WidgetKind::Checkbox: {
+        auto& checkbox = static_cast<CheckboxWidget&>(widget);
+        binding.value = checkbox.get_value();
+        label = add_text(checkbox.get_text());
+        break;
+    }
+    case WidgetKind::RadioButton: {
+        auto& radio = static_cast<RadioButtonWidget&>(widget);
+        binding.value = radio.get_selected();
+        binding.extra = radio.get_value();
+        label = add_text(widget.label_);
+        break;
+    }
+    case WidgetKind::Button:
+        binding.callback = &static_cast<ButtonWidget&>(widget).get_callback();
+        label = add_text(widget.label_);
+        break;
+    case WidgetKind::Table:
+    case WidgetKind::HLayout:
+    case WidgetKind::VLayout:
+    case WidgetKind::Repeat:
+        break;
+    }
+
+    kinds_.push_back(kind);
+    first_child_.push_back(0);
+    child_count_.push_back(0);
+    sorted_by_top_.push_back(widget.is_container() && yoga_node &&
+                             YGNodeStyleGetFlexDirection(yoga_node) == YGFlexDirectionColumn);
+    styles_.push_back(widget.get_style());
+    boxes_.push_back(widget.get_layout());
+    text_scales_.push_back(widget.text_scale());
+    labels_.push_back(label);
+    bindings_.push_back(binding);
+    widgets_.push_back(&widget);
+}
+
+WidgetStore::TextRef WidgetStore::add_text(const std::string& text) {
+    TextRef ref;
+    ref.offset = static_cast<std::uint32_t>(text_.size());
+    ref.length = static_cast<std::uint32_t>(std::min<std::size_t>(text.size(), std::numeric_limits<std::uint32_t>::max()));
+    text_.insert(text_.end(), text.begin(), text.begin() + ref.length);
+    text_.push_back('\0');
+    return ref;
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void WidgetStore::render() {
+    if (!widgets_.empty()) {
+        render_node(0);
+    }
+}
+
+void WidgetStore::render_node(Index node) {
+    switch (kinds_[node]) {
+    case WidgetKind::Repeat:
+    case WidgetKind::HLayout:
+    case WidgetKind::VLayout:
+        if (const Widget::RenderRegion* region = Widget::get_render_region()) {
+            render_children_positioned(node, *region);
+        } else {
+            render_children(node);
+        }
+        break;
+    case WidgetKind::Table:
+        widgets_[node]->render();
+        break;
+    default:
+        render_leaf(node);
+        break;
+    }
+}
+
+void WidgetStore::render_leaf(Index node) {
+    const Widget::Style& style = styles_[node];
+    const Widget::LayoutBox& box = boxes_[node];
+    const Binding& binding = bindings_[node];
+
+    switch (kinds_[node]) {
+    case WidgetKind::Label:
+        widget_draw::label(std::string_view(label(node), labels_[node].length), style, text_scales_[node]);
+        break;
+    case WidgetKind::InputText:
+        widget_draw::input_text(label(node), static_cast<std::string*>(binding.value), style, box);
+        break;
+    case WidgetKind::InputNumber:
+        if (binding.extra) {
+            widget_draw::input_number(label(node), nullptr, static_cast<int*>(binding.value), style, box);
+        } else {
+            widget_draw::input_number(label(node), static_cast<float*>(binding.value), nullptr, style, box);
+        }
+        break;
+    case WidgetKind::Checkbox:
+        widget_draw::checkbox(label(node), static_cast<bool*>(binding.value), style);
+        break;
+    case WidgetKind::RadioButton:
+        widget_draw::radio_button(label(node), static_cast<int*>(binding.value), binding.extra, style);
+        break;
+    case WidgetKind::Button:
+        widget_draw::button(label(node), style, box, text_scales_[node], binding.callback);
+        break;
+    default:
+        break;
+    }
+}
+
+void WidgetStore::render_children(Index node) {
+    // Same flow as the layout widgets' render(): rows side by side, rows of a repeat under their index
+    bool same_line = kinds_[node] == WidgetKind::HLayout;
+    bool scope_ids = kinds_[node] == WidgetKind::Repeat;
+    Index first = first_child_[node];
+    for (Index i = 0; i < child_count_[node]; ++i) {
+        if (same_line && i > 0) {
+            ImGui::SameLine();
+        }
+        if (scope_ids) {
+            ImGui::PushID(static_cast<int>(i));
+        }
+        render_node(first + i);
+        if (scope_ids) {
+            ImGui::PopID();
+        }
+    }
+}
+
+void WidgetStore::render_children_positioned(Index node, const Widget::RenderRegion& region) {
+    // Clip rect in layout coordinates
+    float clip_left = region.clip_min.x - region.origin.x;
+    float clip_top = region.clip_min.y - region.origin.y;
+    float clip_right = region.clip_max.x - region.origin.x;
+    float clip_bottom = region.clip_max.y - region.origin.y;
+
+    bool scope_ids = kinds_[node] == WidgetKind::Repeat;
+    bool column = sorted_by_top_[node];
+    auto boxes = boxes_.begin();
+    Index first = first_child_[node];
+    Index end = first + child_count_[node];
+    Index begin = first;
+    if (column) {
+        begin = static_cast<Index>(std::partition_point(boxes + first, boxes + end, [clip_top](const auto& box) {
+            return box.top + box.height < clip_top;
+        }) - boxes);
+    }
+
+    for (Index child = begin; child < end; ++child) {
+        const Widget::LayoutBox& box = boxes_[child];
+        if (column && box.top > clip_bottom) {
+            break;
+        }
+        if (box.top + box.height < clip_top || box.top > clip_bottom ||
+            box.left + box.width < clip_left || box.left > clip_right) {
+            continue;
+        }
+
+        ImGui::SetCursorScreenPos(ImVec2(region.origin.x + box.left, region.origin.y + box.top));
+        if (scope_ids) {
+            ImGui::PushID(static_cast<int>(child - first));
+        }
+        render_node(child);
+        if (scope_ids) {
+            ImGui::PopID();
+        }
+    }
+}
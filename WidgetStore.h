@@ -0,0 +1,86 @@
+#pragma once
+#include "Widget.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Flat, column-per-field copy of a widget tree for rendering
+ *
+ * Panel's data-oriented backend. build() walks the tree once and copies
+ * what drawing needs into parallel arrays indexed by node: kind, style,
+ * layout box, bound value pointers and label text (one shared character
+ * arena). Nodes are stored breadth first, so a container's children are
+ * the contiguous range [first_child, first_child + child_count) and the
+ * tree is walked by index instead of through child pointers.
+ *
+ * render() then reads the arrays and draws with the widget_draw functions
+ * the widget classes use too, so both backends produce the same frame.
+ * The widget objects stay the source of truth: they own the Yoga nodes,
+ * are what find_widget() returns and what the XML and builder front ends
+ * create. The owning Panel rebuilds the store when its WidgetIndex
+ * version moves and refreshes the boxes after each layout pass; neither
+ * happens, and nothing is allocated, in a steady-state frame.
+ *
+ * Tables keep rendering through their own render(). Repeat rows are
+ * stamped by the panel before layout, so the store is rebuilt with them
+ * before they are first drawn.
+ */
+class WidgetStore {
+public:
+    using Index = std::uint32_t;
+
+    // Drops the previous contents, keeping the arrays' capacity
+    void build(Widget& root);
+    void clear();
+
+    // Copies each widget's current layout box
+    void refresh_layout();
+
+    /**
+     * @brief Draws the tree at the current cursor
+     *
+     * Honours Widget::get_render_region() like the widget classes do:
+     * positioned and culled when a region is set, ImGui flow otherwise.
+     */
+    void render();
+
+    std::size_t size() const { return kinds_.size(); }
+    const Widget* get_root() const { return widgets_.empty() ? nullptr : widgets_.front(); }
+
+private:
+    // Range of a node's label in text_
+    struct TextRef {
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+    };
+
+    // Bound state of a leaf; `extra` is a radio button's value or 1 for an int input
+    struct Binding {
+        void* value = nullptr;
+        const std::function<void()>* callback = nullptr;
+        int extra = 0;
+    };
+
+    std::vector<WidgetKind> kinds_;
+    std::vector<Index> first_child_;
+    std::vector<Index> child_count_;
+    std::vector<bool> sorted_by_top_;  // children of a column, culled by binary search
+    std::vector<Widget::Style> styles_;
+    std::vector<Widget::LayoutBox> boxes_;
+    std::vector<float> text_scales_;
+    std::vector<TextRef> labels_;
+    std::vector<Binding> bindings_;
+    std::vector<char> text_;  // NUL-terminated labels, back to back
+    std::vector<Widget*> widgets_;  // for layout refresh and nodes drawn by their own render()
+
+    void append(Widget& widget);
+    TextRef add_text(const std::string& text);
+    const char* label(Index node) const { return text_.data() + labels_[node].offset; }
+
+    void render_node(Index node);
+    void render_leaf(Index node);
+    void render_children(Index node);
+    void render_children_positioned(Index node, const Widget::RenderRegion& region);
+};
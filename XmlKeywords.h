@@ -0,0 +1,203 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Element and attribute names understood by the XML panel format
+ *
+ * Names are resolved with compile-time perfect hash tables: the seed is
+ * searched during constant evaluation so every keyword lands in its own slot,
+ * and a lookup is one hash plus one string compare.
+ */
+enum class XmlElementType : std::uint8_t {
+    Label,
+    Input,
+    Checkbox,
+    Radio,
+    Button,
+    HLayout,
+    VLayout,
+    Repeat,
+    Table,
+    Column,
+    Count,
+    Unknown = Count,
+};
+
+enum class XmlAttribute : std::uint8_t {
+    Id,
+    Text,
+    Type,
+    Bind,
+    Group,
+    Value,
+    Title,
+    Width,
+    Height,
+    Flex,
+    Margin,
+    Padding,
+    Gap,
+    Justify,
+    Align,
+    AlignSelf,
+    Disabled,
+    Variant,
+    FontSize,
+    Bold,
+    TextColor,
+    BgColor,
+    Stretch,
+    Wrap,
+    Source,
+    As,
+    Options,
+    Count,
+    Unknown = Count,
+};
+
+namespace xml_keywords {
+
+constexpr std::size_t kElementCount = static_cast<std::size_t>(XmlElementType::Count);
+constexpr std::size_t kAttributeCount = static_cast<std::size_t>(XmlAttribute::Count);
+
+constexpr std::array<std::string_view, kElementCount> kElementNames = {
+    "label", "input", "checkbox", "radio", "button", "hlayout", "vlayout", "repeat",
+    "table", "column",
+};
+
+constexpr std::array<std::string_view, kAttributeCount> kAttributeNames = {
+    "id", "text", "type", "bind", "group", "value", "title",
+    "width", "height", "flex", "margin", "padding", "gap",
+    "justify", "align", "align-self", "disabled", "variant",
+    "font-size", "bold", "text-color", "bg-color", "stretch", "wrap",
+    "source", "as", "options",
+};
+
+constexpr std::uint32_t hash(std::string_view key, std::uint32_t seed) {
+    std::uint32_t h = 2166136261u ^ seed;
+    for (char c : key) {
+        h ^= static_cast<std::uint8_t>(c);
+        h *= 16777619u;
+    }
+    // Final avalanche so the low bits used for slot selection depend on the seed
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    return h;
+}
+
+template <typename Enum, std::size_t N>
+class PerfectHashTable {
+public:
+    static constexpr std::size_t kSlots = std::bit_ceil(N * 2);
+    static constexpr std::uint8_t kEmpty = 0xFF;
+    static_assert(N < kEmpty, "Too many keywords for 8-bit slots");
+
+    constexpr explicit PerfectHashTable(const std::array<std::string_view, N>& names) : names_(names) {
+        for (std::uint32_t seed = 0; seed < 100000; ++seed) {
+            if (try_seed(seed)) {
+                seed_ = seed;
+                found_ = true;
+                return;
+            }
+        }
+    }
+
+    constexpr bool found() const { return found_; }
+
+    constexpr Enum find(std::string_view key) const {
+        std::uint8_t slot = slots_[hash(key, seed_) & (kSlots - 1)];
+        if (slot != kEmpty && names_[slot] == key) {
+            return static_cast<Enum>(slot);
+        }
+        return Enum::Unknown;
+    }
+
+    constexpr std::string_view name(Enum value) const {
+        auto index = static_cast<std::size_t>(value);
+        return index < N ? names_[index] : std::string_view("?");
+    }
+
+private:
+    constexpr bool try_seed(std::uint32_t seed) {
+        for (auto& slot : slots_) {
+            slot = kEmpty;
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            auto& slot = slots_[hash(names_[i], seed) & (kSlots - 1)];
+            if (slot != kEmpty) {
+                return false;
+            }
+            slot = static_cast<std::uint8_t>(i);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> names_;
+    std::array<std::uint8_t, kSlots> slots_{};
+    std::uint32_t seed_ = 0;
+    bool found_ = false;
+};
+
+inline constexpr PerfectHashTable<XmlElementType, kElementCount> elements(kElementNames);
+inline constexpr PerfectHashTable<XmlAttribute, kAttributeCount> attributes(kAttributeNames);
+
+static_assert(elements.found(), "No perfect hash seed for element names");
+static_assert(attributes.found(), "No perfect hash seed for attribute names");
+static_assert(elements.find("hlayout") == XmlElementType::HLayout);
+static_assert(attributes.find("align-self") == XmlAttribute::AlignSelf);
+static_assert(attributes.find("unknown") == XmlAttribute::Unknown);
+
+inline bool parse_number(std::string_view text, float& out) {
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && end == text.data() + text.size();
+}
+
+inline bool parse_number(std::string_view text, int& out) {
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && end == text.data() + text.size();
+}
+
+inline bool parse_flag(std::string_view text) {
+    return text == "true" || text == "1";
+}
+
+} // namespace xml_keywords
+
+/**
+ * @brief Attributes of one XML element, collected in a single pass
+ *
+ * Values are views into the parsed document and stay valid while the
+ * document is alive. `present` has one bit per XmlAttribute.
+ */
+struct ElementAttributes {
+    XmlElementType element = XmlElementType::Unknown;
+    std::string_view name;
+    std::array<std::string_view, xml_keywords::kAttributeCount> values{};
+    std::uint32_t present = 0;
+
+    void set(XmlAttribute attribute, std::string_view value) {
+        values[static_cast<std::size_t>(attribute)] = value;
+        present |= 1u << static_cast<std::uint32_t>(attribute);
+    }
+
+    bool has(XmlAttribute attribute) const {
+        return (present & (1u << static_cast<std::uint32_t>(attribute))) != 0;
+    }
+
+    std::string_view get(XmlAttribute attribute, std::string_view fallback = {}) const {
+        return has(attribute) ? values[static_cast<std::size_t>(attribute)] : fallback;
+    }
+
+    std::string str(XmlAttribute attribute, std::string_view fallback = {}) const {
+        return std::string(get(attribute, fallback));
+    }
+};
+
+static_assert(xml_keywords::kAttributeCount <= 32, "ElementAttributes::present holds 32 attributes");
@@ -1,173 +1,141 @@
 #include "XmlParser.h"
+#include "FileWatchService.h"
 #include <tinyxml2.h>
 #include <iostream>
 #include <filesystem>
-#include <ctime>
-#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <bit>
+#include <mutex>
 
 using namespace tinyxml2;
 
+namespace {
+
+// Collects every attribute of an element in one pass over its attribute list
+ElementAttributes read_attributes(const XMLElement& element) {
+    ElementAttributes attributes;
+    attributes.name = element.Name();
+    attributes.element = xml_keywords::elements.find(attributes.name);
+    for (const XMLAttribute* attribute = element.FirstAttribute(); attribute; attribute = attribute->Next()) {
+        XmlAttribute key = xml_keywords::attributes.find(attribute->Name());
+        if (key != XmlAttribute::Unknown) {
+            attributes.set(key, attribute->Value());
+        }
+    }
+    return attributes;
+}
+
+// Parses a numeric attribute, warning about (and ignoring) malformed values
+template <typename T>
+bool read_number(const ElementAttributes& attributes, XmlAttribute key, T& out) {
+    if (!attributes.has(key)) {
+        return false;
+    }
+    if (!xml_keywords::parse_number(attributes.get(key), out)) {
+        std::cerr << "Invalid number '" << attributes.get(key) << "' for attribute '"
+                  << xml_keywords::attributes.name(key) << "' on <" << attributes.name << ">" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Resolves a style name, warning about (and ignoring) unknown values
+template <typename T>
+void read_style(const ElementAttributes& attributes, XmlAttribute key, T& out) {
+    if (!widget_style::parse(attributes.get(key), out)) {
+        std::cerr << "Unknown value '" << attributes.get(key) << "' for attribute '"
+                  << xml_keywords::attributes.name(key) << "' on <" << attributes.name << ">" << std::endl;
+    }
+}
+
+void read_color(const ElementAttributes& attributes, XmlAttribute key, ImU32& out) {
+    if (!widget_style::parse_color(attributes.get(key), out)) {
+        std::cerr << "Unknown color '" << attributes.get(key) << "' for attribute '"
+                  << xml_keywords::attributes.name(key) << "' on <" << attributes.name << ">" << std::endl;
+    }
+}
+
+// Reads a <column>; its bind path is resolved separately against the table's source
+bool read_column(const ElementAttributes& attributes, TableColumn& column, std::string& error_message) {
+    column.header = attributes.str(XmlAttribute::Text);
+    if (attributes.has(XmlAttribute::Type) && !TableColumn::parse_kind(attributes.get(XmlAttribute::Type), column.kind)) {
+        error_message = "Unknown column type '" + attributes.str(XmlAttribute::Type) + "' on column '" +
+                        column.header + "'";
+        return false;
+    }
+    if (attributes.has(XmlAttribute::Flex) && !xml_keywords::parse_number(attributes.get(XmlAttribute::Flex), column.weight)) {
+        error_message = "Invalid number for 'flex' on column '" + column.header + "'";
+        return false;
+    }
+    if (column.kind == TableColumn::Kind::Choice &&
+        !TableColumn::parse_choices(attributes.get(XmlAttribute::Options), column.choices)) {
+        error_message = "Choice column '" + column.header + "' needs options=\"Label:value,...\"";
+        return false;
+    }
+    return true;
+}
+
+// Reads a whole file, leaving `out` empty if it cannot be opened
+void read_file(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (file) {
+        out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+// FNV-1a; tells a touched-but-unchanged file apart from an edited one
+std::uint64_t content_hash(std::string_view bytes) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : bytes) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
 // ============================================================================
 // Element Parsing Strategies Implementation
 // ============================================================================
 
-std::unique_ptr<Widget> LabelParsingStrategy::parse(void* xml_element, AppData* app_data, 
-                                                   const std::map<std::string, std::function<void()>>& callbacks) {
-    XMLElement* element = static_cast<XMLElement*>(xml_element);
-    
-    std::string id = element->Attribute("id") ? element->Attribute("id") : "";
-    std::string text = element->Attribute("text") ? element->Attribute("text") : "";
-    
-    return WidgetFactory::create_label(id, text);
+std::unique_ptr<Widget> LabelParsingStrategy::parse(const ElementAttributes& attributes, AppData* app_data, 
+                                                   const std::map<std::string, std::function<void()>>& callbacks) const {
+    return WidgetFactory::create_label(attributes.str(XmlAttribute::Id), attributes.str(XmlAttribute::Text));
 }
 
-std::unique_ptr<Widget> InputParsingStrategy::parse(void* xml_element, AppData* app_data, 
-                                                   const std::map<std::string, std::function<void()>>& callbacks) {
-    XMLElement* element = static_cast<XMLElement*>(xml_element);
-    
-    std::string id = element->Attribute("id") ? element->Attribute("id") : "";
-    std::string type = element->Attribute("type") ? element->Attribute("type") : "text";
-    std::string bind = element->Attribute("bind") ? element->Attribute("bind") : "";
+std::unique_ptr<Widget> InputParsingStrategy::parse(const ElementAttributes& attributes, AppData* app_data, 
+                                                   const std::map<std::string, std::function<void()>>& callbacks) const {
+    std::string id = attributes.str(XmlAttribute::Id);
+    std::string_view type = attributes.get(XmlAttribute::Type, "text");
     
+    // Bindings are resolved by XmlParser::apply_binding through the registry
     if (type == "text") {
-        auto widget = WidgetFactory::create_input_text(id, nullptr);
-        
-        // Bind to appropriate field
-        if (bind == "name") {
-            widget->bind_value(&app_data->name);
-        } else if (bind == "email") {
-            widget->bind_value(&app_data->email);
-        } else if (bind.find("city_name_") == 0) {
-            try {
-                int city_idx = std::stoi(bind.substr(10));
-                if (city_idx < app_data->cities.size()) {
-                    widget->bind_value(&app_data->cities[city_idx].name);
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error parsing city name index: " << e.what() << std::endl;
-            }
-        }
-        
-        return std::move(widget);
+        return WidgetFactory::create_input_text(id, nullptr);
     } else if (type == "number") {
-        auto widget = WidgetFactory::create_input_number(id);
-        
-        // Bind to appropriate numeric field
-        if (bind.find("city_lat_") == 0) {
-            try {
-                int city_idx = std::stoi(bind.substr(9));
-                if (city_idx < app_data->cities.size()) {
-                    widget->bind_float_value(&app_data->cities[city_idx].latitude);
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error parsing city lat index: " << e.what() << std::endl;
-            }
-        } else if (bind.find("city_lon_") == 0) {
-            try {
-                int city_idx = std::stoi(bind.substr(9));
-                if (city_idx < app_data->cities.size()) {
-                    widget->bind_float_value(&app_data->cities[city_idx].longitude);
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error parsing city lon index: " << e.what() << std::endl;
-            }
-        } else if (bind.find("city_elev_") == 0) {
-            try {
-                int city_idx = std::stoi(bind.substr(10));
-                if (city_idx < app_data->cities.size()) {
-                    widget->bind_int_value(&app_data->cities[city_idx].elevation);
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error parsing city elev index: " << e.what() << std::endl;
-            }
-        } else if (bind.find("city_temp_") == 0) {
-            try {
-                int city_idx = std::stoi(bind.substr(10));
-                if (city_idx < app_data->cities.size()) {
-                    widget->bind_float_value(&app_data->cities[city_idx].avg_temp);
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error parsing city temp index: " << e.what() << std::endl;
-            }
-        } else if (bind.find("city_pop_") == 0) {
-            try {
-                int city_idx = std::stoi(bind.substr(9));
-                if (city_idx < app_data->cities.size()) {
-                    widget->bind_int_value(&app_data->cities[city_idx].population);
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error parsing city pop index: " << e.what() << std::endl;
-            }
-        }
-        
-        return std::move(widget);
+        return WidgetFactory::create_input_number(id);
     }
     
     return nullptr;
 }
 
-std::unique_ptr<Widget> CheckboxParsingStrategy::parse(void* xml_element, AppData* app_data, 
-                                                      const std::map<std::string, std::function<void()>>& callbacks) {
-    XMLElement* element = static_cast<XMLElement*>(xml_element);
-    
-    std::string id = element->Attribute("id") ? element->Attribute("id") : "";
-    std::string text = element->Attribute("text") ? element->Attribute("text") : "";
-    std::string bind = element->Attribute("bind") ? element->Attribute("bind") : "";
-    
-    auto widget = WidgetFactory::create_checkbox(id, text, nullptr);
-    
-    // Bind to appropriate boolean field
-    if (bind == "python") {
-        widget->bind_value(&app_data->python_selected);
-    } else if (bind == "go") {
-        widget->bind_value(&app_data->go_selected);
-    } else if (bind == "swift") {
-        widget->bind_value(&app_data->swift_selected);
-    } else if (bind == "rust") {
-        widget->bind_value(&app_data->rust_selected);
-    } else if (bind == "cpp") {
-        widget->bind_value(&app_data->cpp_selected);
-    }
-    
-    return std::move(widget);
+std::unique_ptr<Widget> CheckboxParsingStrategy::parse(const ElementAttributes& attributes, AppData* app_data, 
+                                                      const std::map<std::string, std::function<void()>>& callbacks) const {
+    return WidgetFactory::create_checkbox(attributes.str(XmlAttribute::Id), attributes.str(XmlAttribute::Text), nullptr);
 }
 
-std::unique_ptr<Widget> RadioParsingStrategy::parse(void* xml_element, AppData* app_data, 
-                                                   const std::map<std::string, std::function<void()>>& callbacks) {
-    XMLElement* element = static_cast<XMLElement*>(xml_element);
-    
-    std::string id = element->Attribute("id") ? element->Attribute("id") : "";
-    std::string text = element->Attribute("text") ? element->Attribute("text") : "";
-    std::string group = element->Attribute("group") ? element->Attribute("group") : "";
-    std::string value_str = element->Attribute("value") ? element->Attribute("value") : "0";
-    std::string bind = element->Attribute("bind") ? element->Attribute("bind") : "";
-    
-    int value = std::stoi(value_str);
-    auto widget = WidgetFactory::create_radio_button(id, text, group, value, nullptr);
-    
-    // Bind to appropriate integer field
-    if (bind.find("city_climate_") == 0) {
-        try {
-            int city_idx = std::stoi(bind.substr(13));
-            if (city_idx < app_data->cities.size()) {
-                widget->bind_selected(&app_data->cities[city_idx].climate_zone);
-            }
-        } catch (const std::exception& e) {
-            std::cerr << "Error parsing city climate index: " << e.what() << std::endl;
-        }
-    }
-    
-    return std::move(widget);
+std::unique_ptr<Widget> RadioParsingStrategy::parse(const ElementAttributes& attributes, AppData* app_data, 
+                                                   const std::map<std::string, std::function<void()>>& callbacks) const {
+    int value = 0;
+    read_number(attributes, XmlAttribute::Value, value);
+    return WidgetFactory::create_radio_button(attributes.str(XmlAttribute::Id), attributes.str(XmlAttribute::Text),
+                                              attributes.str(XmlAttribute::Group), value, nullptr);
 }
 
-std::unique_ptr<Widget> ButtonParsingStrategy::parse(void* xml_element, AppData* app_data, 
-                                                    const std::map<std::string, std::function<void()>>& callbacks) {
-    XMLElement* element = static_cast<XMLElement*>(xml_element);
-    
-    std::string id = element->Attribute("id") ? element->Attribute("id") : "";
-    std::string text = element->Attribute("text") ? element->Attribute("text") : "";
-    
-    auto widget = WidgetFactory::create_button(id, text);
+std::unique_ptr<Widget> ButtonParsingStrategy::parse(const ElementAttributes& attributes, AppData* app_data, 
+                                                    const std::map<std::string, std::function<void()>>& callbacks) const {
+    std::string id = attributes.str(XmlAttribute::Id);
+    auto widget = WidgetFactory::create_button(id, attributes.str(XmlAttribute::Text));
     
     // Set callback if available
     auto callback_it = callbacks.find(id);
@@ -178,35 +146,61 @@ std::unique_ptr<Widget> ButtonParsingStrategy::parse(void* xml_element, AppData*
     return std::move(widget);
 }
 
-std::unique_ptr<Widget> LayoutParsingStrategy::parse(void* xml_element, AppData* app_data, 
-                                                    const std::map<std::string, std::function<void()>>& callbacks) {
-    XMLElement* element = static_cast<XMLElement*>(xml_element);
+std::unique_ptr<Widget> LayoutParsingStrategy::parse(const ElementAttributes& attributes, AppData* app_data, 
+                                                    const std::map<std::string, std::function<void()>>& callbacks) const {
+    std::string id = attributes.str(XmlAttribute::Id);
     
-    std::string id = element->Attribute("id") ? element->Attribute("id") : "";
-    std::string node_name = element->Name();
-    
-    if (node_name == "hlayout") {
+    if (attributes.element == XmlElementType::HLayout) {
         return WidgetFactory::create_hlayout(id);
-    } else if (node_name == "vlayout") {
+    } else if (attributes.element == XmlElementType::VLayout) {
         return WidgetFactory::create_vlayout(id);
     }
     
     return nullptr;
 }
 
+std::unique_ptr<Widget> RepeatParsingStrategy::parse(const ElementAttributes& attributes, AppData* app_data, 
+                                                    const std::map<std::string, std::function<void()>>& callbacks) const {
+    if (!attributes.has(XmlAttribute::Source)) {
+        std::cerr << "<repeat> requires a 'source' attribute" << std::endl;
+        return nullptr;
+    }
+    // The row template is attached by XmlParser::build_repeat
+    return std::make_unique<RepeatWidget>(attributes.str(XmlAttribute::Id), attributes.str(XmlAttribute::Source));
+}
+
+std::unique_ptr<Widget> TableParsingStrategy::parse(const ElementAttributes& attributes, AppData* app_data, 
+                                                   const std::map<std::string, std::function<void()>>& callbacks) const {
+    if (!attributes.has(XmlAttribute::Source)) {
+        std::cerr << "<table> requires a 'source' attribute" << std::endl;
+        return nullptr;
+    }
+    // Columns are attached by XmlParser::build_table
+    return std::make_unique<TableWidget>(attributes.str(XmlAttribute::Id), attributes.str(XmlAttribute::Source));
+}
+
+std::unique_ptr<Widget> ColumnParsingStrategy::parse(const ElementAttributes& attributes, AppData* app_data, 
+                                                    const std::map<std::string, std::function<void()>>& callbacks) const {
+    std::cerr << "<column> is only valid inside <table>" << std::endl;
+    return nullptr;
+}
+
 // ============================================================================
 // XML Parser Implementation
 // ============================================================================
 
 XmlParser::XmlParser() {
-    // Initialize parsing strategies
-    strategies_["label"] = std::make_unique<LabelParsingStrategy>();
-    strategies_["input"] = std::make_unique<InputParsingStrategy>();
-    strategies_["checkbox"] = std::make_unique<CheckboxParsingStrategy>();
-    strategies_["radio"] = std::make_unique<RadioParsingStrategy>();
-    strategies_["button"] = std::make_unique<ButtonParsingStrategy>();
-    strategies_["hlayout"] = std::make_unique<LayoutParsingStrategy>();
-    strategies_["vlayout"] = std::make_unique<LayoutParsingStrategy>();
+    // Initialize parsing strategies, indexed by XmlElementType
+    strategy_for(XmlElementType::Label) = std::make_unique<LabelParsingStrategy>();
+    strategy_for(XmlElementType::Input) = std::make_unique<InputParsingStrategy>();
+    strategy_for(XmlElementType::Checkbox) = std::make_unique<CheckboxParsingStrategy>();
+    strategy_for(XmlElementType::Radio) = std::make_unique<RadioParsingStrategy>();
+    strategy_for(XmlElementType::Button) = std::make_unique<ButtonParsingStrategy>();
+    strategy_for(XmlElementType::HLayout) = std::make_unique<LayoutParsingStrategy>();
+    strategy_for(XmlElementType::VLayout) = std::make_unique<LayoutParsingStrategy>();
+    strategy_for(XmlElementType::Repeat) = std::make_unique<RepeatParsingStrategy>();
+    strategy_for(XmlElementType::Table) = std::make_unique<TableParsingStrategy>();
+    strategy_for(XmlElementType::Column) = std::make_unique<ColumnParsingStrategy>();
 }
 
 XmlParser::~XmlParser() = default;
@@ -224,22 +218,21 @@ std::unique_ptr<Panel> XmlParser::parse_panel_from_file(const std::string& xml_f
         return nullptr;
     }
     
-    std::string title = get_attribute(panel_element, "title", "Panel");
+    ElementAttributes panel_attributes = read_attributes(*panel_element);
     float width = 400.0f;
     float height = 300.0f;
+    read_number(panel_attributes, XmlAttribute::Width, width);
+    read_number(panel_attributes, XmlAttribute::Height, height);
     
-    std::string width_str = get_attribute(panel_element, "width");
-    std::string height_str = get_attribute(panel_element, "height");
-    
-    if (!width_str.empty()) width = std::stof(width_str);
-    if (!height_str.empty()) height = std::stof(height_str);
+    auto panel = std::make_unique<Panel>(panel_attributes.str(XmlAttribute::Title, "Panel"), width, height);
     
-    auto panel = std::make_unique<Panel>(title, width, height);
-    
-    // Parse root widget
+    // Parse root widget; buttons look up their callbacks while being built
     XMLElement* root_element = panel_element->FirstChildElement();
     if (root_element) {
-        auto root_widget = parse_element(root_element);
+        std::shared_lock<std::shared_mutex> callbacks_lock(callbacks_mutex_);
+        WidgetArena::Scope arena_scope(panel->get_widget_arena());
+        std::unique_ptr<Widget> root_widget = parse_element(root_element);
+        
         if (root_widget) {
             std::string validation_error;
             if (validate_layout_hierarchy(root_widget.get(), validation_error)) {
@@ -255,32 +248,30 @@ std::unique_ptr<Panel> XmlParser::parse_panel_from_file(const std::string& xml_f
     return panel;
 }
 
-std::unique_ptr<Widget> XmlParser::parse_element(void* xml_element) {
+std::unique_ptr<Widget> XmlParser::parse_element(void* xml_element, TemplateScope* scope) {
     XMLElement* element = static_cast<XMLElement*>(xml_element);
-    std::string node_name = element->Name();
-    std::string id = get_attribute(element, "id");
-    
-    std::unique_ptr<Widget> widget;
-    
-    // Use strategy pattern to parse different element types
-    auto strategy_it = strategies_.find(node_name);
-    if (strategy_it != strategies_.end()) {
-        widget = strategy_it->second->parse(xml_element, app_data_, button_callbacks_);
-    }
     
+    auto widget = build_widget(xml_element, scope);
     if (!widget) {
-        std::cerr << "Unknown element type: " << node_name << std::endl;
         return nullptr;
     }
     
-    // Apply common properties
-    apply_properties_to_widget(*widget, xml_element);
+    switch (widget->get_kind()) {
+    case WidgetKind::Repeat:
+        build_repeat(static_cast<RepeatWidget&>(*widget), xml_element, scope);
+        return widget;
+    case WidgetKind::Table:
+        build_table(static_cast<TableWidget&>(*widget), xml_element);
+        return widget;
+    default:
+        break;
+    }
     
     // Parse children for container widgets
-    ContainerWidget* container = dynamic_cast<ContainerWidget*>(widget.get());
+    ContainerWidget* container = widget_cast<ContainerWidget>(widget.get());
     if (container) {
         for (XMLElement* child = element->FirstChildElement(); child; child = child->NextSiblingElement()) {
-            auto child_widget = parse_element(child);
+            auto child_widget = parse_element(child, scope);
             if (child_widget) {
                 container->add_child(std::move(child_widget));
             }
@@ -290,148 +281,876 @@ std::unique_ptr<Widget> XmlParser::parse_element(void* xml_element) {
     return widget;
 }
 
-void XmlParser::apply_properties_to_widget(Widget& widget, void* xml_element) {
+std::unique_ptr<Widget> XmlParser::build_widget(void* xml_element, TemplateScope* scope) {
+    ElementAttributes attributes = read_attributes(*static_cast<XMLElement*>(xml_element));
+    
+    if (scope && attributes.element == XmlElementType::Repeat) {
+        std::cerr << "Nested <repeat> elements are not supported" << std::endl;
+        return nullptr;
+    }
+    if (scope && attributes.element == XmlElementType::Table) {
+        std::cerr << "<table> is not supported inside a <repeat> row template" << std::endl;
+        return nullptr;
+    }
+    
+    std::unique_ptr<Widget> widget;
+    
+    // Use strategy pattern to parse different element types
+    if (attributes.element != XmlElementType::Unknown) {
+        widget = strategy_for(attributes.element)->parse(attributes, app_data_, button_callbacks_);
+    }
+    
+    if (!widget) {
+        std::cerr << "Unknown element type: " << attributes.name << std::endl;
+        return nullptr;
+    }
+    
+    // Apply common properties
+    apply_properties_to_widget(*widget, attributes);
+    bind_or_record(*widget, attributes.get(XmlAttribute::Bind), scope);
+    
+    return widget;
+}
+
+void XmlParser::build_repeat(RepeatWidget& repeat, void* xml_element, const TemplateScope* scope) {
     XMLElement* element = static_cast<XMLElement*>(xml_element);
+    XMLElement* template_element = element->FirstChildElement();
+    if (!template_element) {
+        std::cerr << "<repeat> '" << repeat.get_id() << "' has no row template" << std::endl;
+        return;
+    }
+    if (template_element->NextSiblingElement()) {
+        std::cerr << "<repeat> '" << repeat.get_id() << "' uses only its first child as the row template" << std::endl;
+    }
     
-    // Layout properties
-    std::string width_str = get_attribute(element, "width");
-    std::string height_str = get_attribute(element, "height");
-    std::string flex_str = get_attribute(element, "flex");
+    // Alias and source stay valid while the document and repeat are alive
+    TemplateScope row_scope;
+    row_scope.alias = read_attributes(*element).get(XmlAttribute::As);
+    row_scope.source = repeat.get_source();
     
-    if (!width_str.empty()) {
-        widget.set_width(std::stof(width_str));
+    auto prototype = parse_element(template_element, &row_scope);
+    finish_repeat(repeat, std::move(prototype), row_scope);
+}
+
+void XmlParser::finish_repeat(RepeatWidget& repeat, std::unique_ptr<Widget> prototype, TemplateScope& row_scope,
+                              const BindingContext& context) {
+    if (!prototype) {
+        return;
+    }
+    repeat.set_template(std::move(prototype), std::move(row_scope.bindings));
+    
+    AppData* data = context.app_data ? context.app_data : app_data_;
+    const BindingRegistry& registry = context.registry ? *context.registry : *binding_registry_;
+    if (data) {
+        repeat.bind_source(data, registry);
+        if (!registry.find_collection(repeat.get_source())) {
+            std::cerr << "Unknown repeat source '" << repeat.get_source() << "'" << std::endl;
+        }
+        repeat.sync_rows();
     }
-    if (!height_str.empty()) {
-        widget.set_height(std::stof(height_str));
+}
+
+void XmlParser::build_table(TableWidget& table, void* xml_element) {
+    XMLElement* element = static_cast<XMLElement*>(xml_element);
+    std::string_view alias = read_attributes(*element).get(XmlAttribute::As);
+    
+    for (XMLElement* child = element->FirstChildElement(); child; child = child->NextSiblingElement()) {
+        ElementAttributes attributes = read_attributes(*child);
+        if (attributes.element != XmlElementType::Column) {
+            std::cerr << "<table> '" << table.get_id() << "' ignores <" << attributes.name
+                      << ">: only <column> children are allowed" << std::endl;
+            continue;
+        }
+        
+        TableColumn column;
+        std::string error_message;
+        if (!read_column(attributes, column, error_message)) {
+            std::cerr << error_message << std::endl;
+            continue;
+        }
+        add_table_column(table, std::move(column), attributes.get(XmlAttribute::Bind), alias);
     }
-    if (!flex_str.empty()) {
-        widget.set_flex(std::stof(flex_str));
+    finish_table(table);
+}
+
+void XmlParser::add_table_column(TableWidget& table, TableColumn column, std::string_view bind_path,
+                                 std::string_view alias, const BindingContext& context) {
+    AppData* data = context.app_data ? context.app_data : app_data_;
+    const BindingRegistry& registry = context.registry ? *context.registry : *binding_registry_;
+    
+    // Compiled once per column; each visible cell only applies its row index
+    if (data && !bind_path.empty()) {
+        std::string path = BindingRegistry::expand_alias(bind_path, alias, table.get_source());
+        CompiledBinding binding = registry.compile(path);
+        if (binding.is_indexed()) {
+            column.type = binding.type();
+            column.access = [data, binding](std::size_t row) { return binding.with_index(row).resolve(*data).address; };
+        } else {
+            std::cerr << "Column binding '" << bind_path << "' on table '" << table.get_id()
+                      << "' does not address an element of '" << table.get_source() << "'" << std::endl;
+        }
+    }
+    
+    if (column.kind == TableColumn::Kind::Choice && column.type != BindingType::Int && column.access) {
+        std::cerr << "Choice column '" << column.header << "' needs an int binding" << std::endl;
+        column.kind = TableColumn::Kind::Input;
+    }
+    table.add_column(std::move(column));
+}
+
+void XmlParser::finish_table(TableWidget& table, const BindingContext& context) {
+    AppData* data = context.app_data ? context.app_data : app_data_;
+    const BindingRegistry& registry = context.registry ? *context.registry : *binding_registry_;
+    if (!data) {
+        return;
+    }
+    const BindingRegistry::CollectionSize* size = registry.find_collection(table.get_source());
+    if (!size) {
+        std::cerr << "Unknown table source '" << table.get_source() << "'" << std::endl;
+        return;
+    }
+    table.set_row_count([data, size]() { return (*size)(*data); });
+}
+
+void XmlParser::apply_properties_to_widget(Widget& widget, const ElementAttributes& attributes) {
+    // Layout properties
+    float value = 0.0f;
+    if (read_number(attributes, XmlAttribute::Width, value)) {
+        widget.set_width(value);
+    }
+    if (read_number(attributes, XmlAttribute::Height, value)) {
+        widget.set_height(value);
+    }
+    if (read_number(attributes, XmlAttribute::Flex, value)) {
+        widget.set_flex(value);
     }
     
     // Apply style properties
-    apply_style_properties(widget.get_style(), xml_element);
+    apply_style_properties(widget.get_style(), attributes);
     
     // Re-setup yoga layout with new properties
     widget.setup_yoga_layout();
 }
 
-void XmlParser::apply_style_properties(Widget::Style& style, void* xml_element) {
+void XmlParser::apply_style_properties(Widget::Style& style, const ElementAttributes& attributes) {
+    // Visit only the attributes that are present, lowest bit first
+    for (std::uint32_t bits = attributes.present; bits != 0; bits &= bits - 1) {
+        auto key = static_cast<XmlAttribute>(std::countr_zero(bits));
+        std::string_view value = attributes.values[static_cast<std::size_t>(key)];
+        
+        switch (key) {
+        // Spacing
+        case XmlAttribute::Margin:    read_number(attributes, key, style.margin); break;
+        case XmlAttribute::Padding:   read_number(attributes, key, style.padding); break;
+        case XmlAttribute::Gap:       read_number(attributes, key, style.gap); break;
+        
+        // Alignment
+        case XmlAttribute::Justify:   read_style(attributes, key, style.justify); break;
+        case XmlAttribute::Align:     read_style(attributes, key, style.align); break;
+        case XmlAttribute::AlignSelf: read_style(attributes, key, style.align_self); break;
+        
+        // Appearance
+        case XmlAttribute::Disabled:  style.disabled = xml_keywords::parse_flag(value); break;
+        case XmlAttribute::Variant:   read_style(attributes, key, style.variant); break;
+        
+        // Text
+        case XmlAttribute::FontSize:  read_style(attributes, key, style.font_size); break;
+        case XmlAttribute::Bold:      style.bold = xml_keywords::parse_flag(value); break;
+        
+        // Colors
+        case XmlAttribute::TextColor: read_color(attributes, key, style.text_color); break;
+        case XmlAttribute::BgColor:   read_color(attributes, key, style.bg_color); break;
+        
+        // Behavior
+        case XmlAttribute::Stretch:   style.stretch = xml_keywords::parse_flag(value); break;
+        case XmlAttribute::Wrap:      style.wrap = xml_keywords::parse_flag(value); break;
+        
+        default: break;
+        }
+    }
+}
+
+void XmlParser::bind_or_record(Widget& widget, std::string_view bind_path, TemplateScope* scope,
+                               const BindingContext& context) {
+    if (!scope) {
+        apply_binding(widget, bind_path, context);
+        return;
+    }
+    
+    std::size_t index = scope->next_index++;
+    if (bind_path.empty()) {
+        return;
+    }
+    
+    const BindingRegistry& registry = context.registry ? *context.registry : *binding_registry_;
+    std::string path = BindingRegistry::expand_alias(bind_path, scope->alias, scope->source);
+    CompiledBinding binding = registry.compile(path);
+    if (!binding.valid()) {
+        std::cerr << "Unresolved binding '" << bind_path << "' in row template" << std::endl;
+        return;
+    }
+    scope->bindings.push_back({index, binding});
+}
+
+void XmlParser::apply_binding(Widget& widget, std::string_view bind_path, const BindingContext& context) {
+    AppData* data = context.app_data ? context.app_data : app_data_;
+    if (bind_path.empty() || !data) {
+        return;
+    }
+    
+    const BindingRegistry& registry = context.registry ? *context.registry : *binding_registry_;
+    CompiledBinding binding;
+    if (context.alias.empty()) {
+        binding = registry.compile(bind_path);
+    } else {
+        // Paths through the alias address the context's collection element
+        std::string path = BindingRegistry::expand_alias(bind_path, context.alias, context.source);
+        binding = registry.compile(path);
+        if (path != bind_path) {
+            binding = binding.with_index(context.index);
+        }
+    }
+    
+    BoundValue value = binding.resolve(*data);
+    if (value.type == BindingType::None) {
+        std::cerr << "Unresolved binding '" << bind_path << "' on widget '" << widget.get_id() << "'" << std::endl;
+        return;
+    }
+    
+    bind_widget(widget, value);
+}
+
+void XmlParser::add_button_callback(const std::string& id, std::function<void()> callback) {
+    std::unique_lock<std::shared_mutex> lock(callbacks_mutex_);
+    button_callbacks_[id] = callback;
+}
+
+void XmlParser::remove_button_callback(const std::string& id) {
+    std::unique_lock<std::shared_mutex> lock(callbacks_mutex_);
+    button_callbacks_.erase(id);
+}
+
+void XmlParser::clear_callbacks() {
+    std::unique_lock<std::shared_mutex> lock(callbacks_mutex_);
+    button_callbacks_.clear();
+}
+
+bool XmlParser::reload_panel(Panel& panel, const std::string& xml_file, ReconcileStats* stats) {
+    // Revalidate the cached blueprint; it is only recompiled if the content changed
+    invalidate_blueprint(xml_file);
+    auto new_panel = load_panel(xml_file);
+    if (!new_panel) {
+        return false;
+    }
+    
+    ReconcileStats result = PanelReconciler::reconcile(panel, *new_panel);
+    if (stats) {
+        *stats = result;
+    }
+    return true;
+}
+
+std::future<std::unique_ptr<Panel>> XmlParser::reload_panel_async(const Panel& live, const std::string& xml_file,
+                                                               ThreadPool& pool) {
+    float dpi_scale = live.get_dpi_scale();
+    float content_width = live.get_last_layout_width();
+    float content_height = live.get_last_layout_height();
+    
+    invalidate_blueprint(xml_file);
+    return pool.submit([this, xml_file, dpi_scale, content_width, content_height]() {
+        auto panel = load_panel(xml_file);
+        if (panel) {
+            if (dpi_scale != 1.0f) {
+                panel->set_dpi_scale(dpi_scale);
+            }
+            if (content_width > 0.0f && content_height > 0.0f) {
+                panel->prepare_layout(content_width, content_height);
+            }
+        }
+        return panel;
+    });
+}
+
+// ============================================================================
+// Blueprint Compilation and Loading
+// ============================================================================
+
+std::string XmlParser::blueprint_path_for(const std::string& xml_file) {
+    return std::filesystem::path(xml_file).replace_extension(".xmlb").string();
+}
+
+bool XmlParser::compile_panel_blueprint(const std::string& xml_file, const std::string& blueprint_file,
+                                        std::string& error_message) {
+    XMLDocument doc;
+    if (doc.LoadFile(xml_file.c_str()) != XML_SUCCESS) {
+        error_message = "Failed to load XML file: " + xml_file;
+        return false;
+    }
+    
+    PanelBlueprintWriter writer;
+    if (!compile_panel_element(doc.FirstChildElement("panel"), writer, error_message)) {
+        return false;
+    }
+    return writer.write(blueprint_file, error_message);
+}
+
+bool XmlParser::compile_panel_element(void* xml_element, PanelBlueprintWriter& writer, std::string& error_message) {
+    XMLElement* panel_element = static_cast<XMLElement*>(xml_element);
+    if (!panel_element) {
+        error_message = "No panel element found in XML";
+        return false;
+    }
+    
+    ElementAttributes panel_attributes = read_attributes(*panel_element);
+    float width = 400.0f;
+    float height = 300.0f;
+    read_number(panel_attributes, XmlAttribute::Width, width);
+    read_number(panel_attributes, XmlAttribute::Height, height);
+    
+    writer.set_panel(panel_attributes.get(XmlAttribute::Title, "Panel"), width, height);
+    
+    XMLElement* root_element = panel_element->FirstChildElement();
+    return !root_element || compile_element(root_element, writer, error_message);
+}
+
+bool XmlParser::compile_element(void* xml_element, PanelBlueprintWriter& writer, std::string& error_message,
+                                bool in_template) {
     XMLElement* element = static_cast<XMLElement*>(xml_element);
+    ElementAttributes attributes = read_attributes(*element);
     
-    // Spacing
-    std::string margin_str = get_attribute(element, "margin");
-    if (!margin_str.empty()) {
-        style.margin = std::stof(margin_str);
+    blueprint::NodeKind kind;
+    switch (attributes.element) {
+    case XmlElementType::Label:    kind = blueprint::NodeKind::Label; break;
+    case XmlElementType::Checkbox: kind = blueprint::NodeKind::Checkbox; break;
+    case XmlElementType::Radio:    kind = blueprint::NodeKind::Radio; break;
+    case XmlElementType::Button:   kind = blueprint::NodeKind::Button; break;
+    case XmlElementType::HLayout:  kind = blueprint::NodeKind::HLayout; break;
+    case XmlElementType::VLayout:  kind = blueprint::NodeKind::VLayout; break;
+    case XmlElementType::Repeat:
+        if (in_template) {
+            error_message = "Nested <repeat> elements are not supported";
+            return false;
+        }
+        if (!attributes.has(XmlAttribute::Source)) {
+            error_message = "<repeat> requires a 'source' attribute";
+            return false;
+        }
+        kind = blueprint::NodeKind::Repeat;
+        break;
+    case XmlElementType::Table:
+        if (in_template) {
+            error_message = "<table> is not supported inside a <repeat> row template";
+            return false;
+        }
+        if (!attributes.has(XmlAttribute::Source)) {
+            error_message = "<table> requires a 'source' attribute";
+            return false;
+        }
+        kind = blueprint::NodeKind::Table;
+        break;
+    case XmlElementType::Column:
+        error_message = "<column> is only valid inside <table>";
+        return false;
+    case XmlElementType::Input: {
+        std::string_view type = attributes.get(XmlAttribute::Type, "text");
+        if (type == "text") {
+            kind = blueprint::NodeKind::InputText;
+        } else if (type == "number") {
+            kind = blueprint::NodeKind::InputNumber;
+        } else {
+            std::cerr << "Unknown input type: " << type << std::endl;
+            return true;
+        }
+        break;
     }
+    default:
+        std::cerr << "Unknown element type: " << attributes.name << std::endl;
+        return true;
+    }
+    
+    std::size_t index = writer.add_node(kind);
+    auto intern_attribute = [&](XmlAttribute key) {
+        return attributes.has(key) ? writer.intern(attributes.get(key)) : blueprint::kNoString;
+    };
     
-    std::string padding_str = get_attribute(element, "padding");
-    if (!padding_str.empty()) {
-        style.padding = std::stof(padding_str);
+    blueprint::Node& node = writer.node(index);
+    node.id = intern_attribute(XmlAttribute::Id);
+    node.text = intern_attribute(XmlAttribute::Text);
+    if (kind == blueprint::NodeKind::Repeat || kind == blueprint::NodeKind::Table) {
+        node.bind = intern_attribute(XmlAttribute::Source);
+        node.group = intern_attribute(XmlAttribute::As);
+    } else {
+        node.bind = intern_attribute(XmlAttribute::Bind);
+        node.group = intern_attribute(XmlAttribute::Group);
     }
+
+    struct NumericAttribute {
+        XmlAttribute key;
+        float* target;
+        std::uint16_t flag;
+    };
+    const NumericAttribute numeric_attributes[] = {
+        {XmlAttribute::Width, &node.width, blueprint::kHasWidth},
+        {XmlAttribute::Height, &node.height, blueprint::kHasHeight},
+        {XmlAttribute::Flex, &node.flex, blueprint::kHasFlex},
+        {XmlAttribute::Margin, &node.margin, blueprint::kHasMargin},
+        {XmlAttribute::Padding, &node.padding, blueprint::kHasPadding},
+        {XmlAttribute::Gap, &node.gap, blueprint::kHasGap},
+    };
     
-    std::string gap_str = get_attribute(element, "gap");
-    if (!gap_str.empty()) {
-        style.gap = std::stof(gap_str);
+    for (const auto& numeric : numeric_attributes) {
+        if (!attributes.has(numeric.key)) {
+            continue;
+        }
+        if (!xml_keywords::parse_number(attributes.get(numeric.key), *numeric.target)) {
+            error_message = "Invalid number for '" + std::string(xml_keywords::attributes.name(numeric.key)) +
+                            "' on <" + std::string(attributes.name) + "> '" + attributes.str(XmlAttribute::Id) + "'";
+            return false;
+        }
+        node.flags |= numeric.flag;
     }
+    if (attributes.has(XmlAttribute::Value) &&
+        !xml_keywords::parse_number(attributes.get(XmlAttribute::Value), node.value)) {
+        error_message = "Invalid radio value on '" + attributes.str(XmlAttribute::Id) + "'";
+        return false;
+    }
+    
+    // Style names are resolved now so instantiation copies plain values
+    Widget::Style style;
+    apply_style_properties(style, attributes);
+    node.justify = static_cast<std::uint8_t>(style.justify);
+    node.align = static_cast<std::uint8_t>(style.align);
+    node.align_self = static_cast<std::uint8_t>(style.align_self);
+    node.variant = static_cast<std::uint8_t>(style.variant);
+    node.font_size = static_cast<std::uint8_t>(style.font_size);
+    node.text_color = style.text_color;
+    node.bg_color = style.bg_color;
+    
+    if (xml_keywords::parse_flag(attributes.get(XmlAttribute::Disabled))) node.flags |= blueprint::kDisabled;
+    if (xml_keywords::parse_flag(attributes.get(XmlAttribute::Bold))) node.flags |= blueprint::kBold;
+    if (xml_keywords::parse_flag(attributes.get(XmlAttribute::Stretch))) node.flags |= blueprint::kStretch;
+    if (xml_keywords::parse_flag(attributes.get(XmlAttribute::Wrap))) node.flags |= blueprint::kWrap;
     
-    // Alignment
-    style.justify = get_attribute(element, "justify", style.justify);
-    style.align = get_attribute(element, "align", style.align);
-    style.align_self = get_attribute(element, "align-self", style.align_self);
+    // A repeat's only child is its row template; blueprints require one
+    if (kind == blueprint::NodeKind::Repeat) {
+        XMLElement* template_element = element->FirstChildElement();
+        std::size_t before = writer.node_count();
+        if (template_element && !compile_element(template_element, writer, error_message, true)) {
+            return false;
+        }
+        if (writer.node_count() == before) {
+            error_message = "<repeat> '" + attributes.str(XmlAttribute::Id) + "' has no row template";
+            return false;
+        }
+        writer.node(index).child_count = 1;
+    }
+    
+    // Columns follow their table as Column nodes, with the kind resolved
+    if (kind == blueprint::NodeKind::Table) {
+        std::uint32_t column_count = 0;
+        for (XMLElement* child = element->FirstChildElement(); child; child = child->NextSiblingElement()) {
+            ElementAttributes column_attributes = read_attributes(*child);
+            if (column_attributes.element != XmlElementType::Column) {
+                error_message = "<table> '" + attributes.str(XmlAttribute::Id) + "' contains <" +
+                                std::string(column_attributes.name) + ">; only <column> children are allowed";
+                return false;
+            }
+            TableColumn column;
+            if (!read_column(column_attributes, column, error_message)) {
+                return false;
+            }
+            
+            blueprint::Node& column_node = writer.node(writer.add_node(blueprint::NodeKind::Column));
+            column_node.text = writer.intern(column.header);
+            if (column_attributes.has(XmlAttribute::Bind)) {
+                column_node.bind = writer.intern(column_attributes.get(XmlAttribute::Bind));
+            }
+            if (column_attributes.has(XmlAttribute::Options)) {
+                column_node.group = writer.intern(column_attributes.get(XmlAttribute::Options));
+            }
+            column_node.value = static_cast<std::int32_t>(column.kind);
+            column_node.flex = column.weight;
+            column_node.flags |= blueprint::kHasFlex;
+            ++column_count;
+        }
+        writer.node(index).child_count = column_count;
+    }
     
-    // Appearance
-    std::string disabled_str = get_attribute(element, "disabled");
-    if (!disabled_str.empty()) {
-        style.disabled = (disabled_str == "true" || disabled_str == "1");
+    // Children follow in pre-order; count only those that produced a node
+    if (kind == blueprint::NodeKind::HLayout || kind == blueprint::NodeKind::VLayout) {
+        std::uint32_t child_count = 0;
+        for (XMLElement* child = element->FirstChildElement(); child; child = child->NextSiblingElement()) {
+            std::size_t before = writer.node_count();
+            if (!compile_element(child, writer, error_message, in_template)) {
+                return false;
+            }
+            if (writer.node_count() > before) {
+                ++child_count;
+            }
+        }
+        writer.node(index).child_count = child_count;
     }
     
-    style.variant = get_attribute(element, "variant", style.variant);
+    return true;
+}
+
+std::unique_ptr<Panel> XmlParser::load_panel_blueprint(const std::string& blueprint_file) {
+    std::string error_message;
+    auto blueprint = PanelBlueprint::load(blueprint_file, error_message);
+    if (!blueprint) {
+        std::cerr << error_message << std::endl;
+        return nullptr;
+    }
+    return instantiate(*blueprint);
+}
+
+std::unique_ptr<Panel> XmlParser::load_panel(const std::string& xml_file) {
+    if (auto blueprint = get_blueprint(xml_file)) {
+        return instantiate(*blueprint);
+    }
+    // The DOM path tolerates malformed values that fail blueprint compilation
+    return parse_panel_from_file(xml_file);
+}
+
+std::string XmlParser::blueprint_cache_key(const std::string& xml_file) {
+    std::error_code ec;
+    std::filesystem::path path = std::filesystem::absolute(xml_file, ec);
+    return ec ? xml_file : path.lexically_normal().string();
+}
+
+std::shared_ptr<const PanelBlueprint> XmlParser::get_blueprint(const std::string& xml_file) {
+    std::string key = blueprint_cache_key(xml_file);
+    {
+        std::lock_guard<std::mutex> lock(blueprint_cache_mutex_);
+        auto it = blueprint_cache_.find(key);
+        if (it != blueprint_cache_.end() && !it->second.stale) {
+            return it->second.blueprint;
+        }
+    }
+    
+    std::string source;
+    read_file(xml_file, source);
+    std::uint64_t hash = content_hash(source);
+    {
+        // Saved without changes, or another thread compiled this content meanwhile
+        std::lock_guard<std::mutex> lock(blueprint_cache_mutex_);
+        auto it = blueprint_cache_.find(key);
+        if (it != blueprint_cache_.end() && !source.empty() && it->second.content_hash == hash) {
+            it->second.stale = false;
+            return it->second.blueprint;
+        }
+    }
+    
+    // Compile outside the lock so other files keep loading in parallel
+    auto blueprint = compile_blueprint(xml_file, source);
+    if (!blueprint) {
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(blueprint_cache_mutex_);
+    blueprint_cache_[key] = CachedBlueprint{hash, blueprint, false};
+    return blueprint;
+}
+
+std::shared_ptr<const PanelBlueprint> XmlParser::compile_blueprint(const std::string& xml_file,
+                                                                   const std::string& source) {
+    std::string error_message;
     
-    // Text
-    style.font_size = get_attribute(element, "font-size", style.font_size);
+    // Prefer a compiled blueprint unless the XML source is newer
+    std::string blueprint_file = blueprint_path_for(xml_file);
+    std::error_code ec;
+    auto blueprint_time = std::filesystem::last_write_time(blueprint_file, ec);
+    if (!ec) {
+        auto xml_time = std::filesystem::last_write_time(xml_file, ec);
+        if (ec || blueprint_time >= xml_time) {
+            if (auto blueprint = PanelBlueprint::load(blueprint_file, error_message)) {
+                return blueprint;
+            }
+            std::cerr << error_message << std::endl;
+        }
+    }
     
-    std::string bold_str = get_attribute(element, "bold");
-    if (!bold_str.empty()) {
-        style.bold = (bold_str == "true" || bold_str == "1");
+    if (source.empty()) {
+        std::cerr << "Failed to load XML file: " << xml_file << std::endl;
+        return nullptr;
     }
     
-    // Colors
-    style.text_color = get_attribute(element, "text-color", style.text_color);
-    style.bg_color = get_attribute(element, "bg-color", style.bg_color);
+    XMLDocument doc;
+    if (doc.Parse(source.data(), source.size()) != XML_SUCCESS) {
+        std::cerr << "Failed to parse XML file: " << xml_file << std::endl;
+        return nullptr;
+    }
     
-    // Behavior
-    std::string stretch_str = get_attribute(element, "stretch");
-    if (!stretch_str.empty()) {
-        style.stretch = (stretch_str == "true" || stretch_str == "1");
+    PanelBlueprintWriter writer;
+    if (!compile_panel_element(doc.FirstChildElement("panel"), writer, error_message)) {
+        std::cerr << "Cannot compile " << xml_file << ": " << error_message << std::endl;
+        return nullptr;
     }
     
-    std::string wrap_str = get_attribute(element, "wrap");
-    if (!wrap_str.empty()) {
-        style.wrap = (wrap_str == "true" || wrap_str == "1");
+    auto blueprint = PanelBlueprint::from_bytes(writer.serialize(), error_message);
+    if (!blueprint) {
+        std::cerr << error_message << std::endl;
     }
+    return blueprint;
 }
 
-std::string XmlParser::get_attribute(void* xml_element, const std::string& name, const std::string& default_value) {
-    XMLElement* element = static_cast<XMLElement*>(xml_element);
-    const char* attr = element->Attribute(name.c_str());
-    return attr ? std::string(attr) : default_value;
+void XmlParser::invalidate_blueprint(const std::string& xml_file) {
+    std::lock_guard<std::mutex> lock(blueprint_cache_mutex_);
+    auto it = blueprint_cache_.find(blueprint_cache_key(xml_file));
+    if (it != blueprint_cache_.end()) {
+        it->second.stale = true;
+    }
 }
 
-void XmlParser::add_button_callback(const std::string& id, std::function<void()> callback) {
-    button_callbacks_[id] = callback;
+void XmlParser::clear_blueprint_cache() {
+    std::lock_guard<std::mutex> lock(blueprint_cache_mutex_);
+    blueprint_cache_.clear();
 }
 
-void XmlParser::remove_button_callback(const std::string& id) {
-    button_callbacks_.erase(id);
+std::vector<std::future<std::unique_ptr<Panel>>> XmlParser::parse_panels_async(
+    const std::vector<std::string>& xml_files, ThreadPool& pool) {
+    std::vector<std::future<std::unique_ptr<Panel>>> panels;
+    panels.reserve(xml_files.size());
+    for (const auto& xml_file : xml_files) {
+        panels.push_back(pool.submit([this, xml_file]() { return load_panel(xml_file); }));
+    }
+    return panels;
 }
 
-void XmlParser::clear_callbacks() {
-    button_callbacks_.clear();
+std::unique_ptr<Panel> XmlParser::instantiate(const PanelBlueprint& blueprint, const BindingContext& context) {
+    auto panel = std::make_unique<Panel>(std::string(blueprint.title()), blueprint.width(), blueprint.height());
+    std::shared_lock<std::shared_mutex> callbacks_lock(callbacks_mutex_);
+    WidgetArena::Scope arena_scope(panel->get_widget_arena());
+    
+    // Rebuild the hierarchy from the pre-order table with an explicit stack
+    struct OpenContainer {
+        ContainerWidget* container;
+        std::uint32_t remaining;
+    };
+    std::vector<OpenContainer> open_containers;
+    std::unique_ptr<Widget> root_widget;
+    
+    for (std::size_t i = 0; i < blueprint.node_count();) {
+        std::size_t node_index = i++;
+        const blueprint::Node& node = blueprint.nodes()[node_index];
+        auto widget = create_widget_from_node(blueprint, node, nullptr, context);
+        if (!widget) {
+            std::cerr << "Blueprint node " << node_index << " cannot be built here" << std::endl;
+            return nullptr;
+        }
+        Widget* raw_widget = widget.get();
+        
+        // The row template follows its repeat node and is consumed here
+        bool is_repeat = node.kind == blueprint::NodeKind::Repeat;
+        if (is_repeat && node.child_count > 0) {
+            TemplateScope row_scope;
+            row_scope.alias = blueprint.string(node.group);
+            row_scope.source = blueprint.string(node.bind);
+            auto prototype = build_blueprint_subtree(blueprint, i, &row_scope, context);
+            finish_repeat(static_cast<RepeatWidget&>(*widget), std::move(prototype), row_scope, context);
+        }
+        
+        // So do a table's columns
+        bool is_table = node.kind == blueprint::NodeKind::Table;
+        if (is_table) {
+            build_blueprint_table(static_cast<TableWidget&>(*widget), blueprint, node, i, context);
+        }
+        
+        if (open_containers.empty()) {
+            if (root_widget) {
+                std::cerr << "Blueprint contains more than one root widget" << std::endl;
+                return nullptr;
+            }
+            root_widget = std::move(widget);
+        } else {
+            open_containers.back().container->add_child(std::move(widget));
+            if (--open_containers.back().remaining == 0) {
+                open_containers.pop_back();
+            }
+        }
+        
+        if (node.child_count > 0 && !is_repeat && !is_table) {
+            ContainerWidget* container = widget_cast<ContainerWidget>(raw_widget);
+            if (!container) {
+                std::cerr << "Blueprint node " << node_index << " has children but is not a container" << std::endl;
+                return nullptr;
+            }
+            container->reserve_children(node.child_count);
+            open_containers.push_back({container, node.child_count});
+        }
+    }
+    
+    if (!open_containers.empty()) {
+        std::cerr << "Blueprint node table is truncated" << std::endl;
+        return nullptr;
+    }
+    
+    if (root_widget) {
+        std::string validation_error;
+        if (!validate_layout_hierarchy(root_widget.get(), validation_error)) {
+            std::cerr << "Layout validation error: " << validation_error << std::endl;
+        }
+        panel->set_root_widget(std::move(root_widget));
+    }
+    
+    return panel;
 }
 
-bool XmlParser::reload_panel(Panel& panel, const std::string& xml_file) {
-    auto new_panel = parse_panel_from_file(xml_file);
-    if (new_panel) {
-        panel.set_title(new_panel->get_title());
-        panel.set_width(new_panel->get_width());
-        panel.set_height(new_panel->get_height());
+std::unique_ptr<Widget> XmlParser::build_blueprint_subtree(const PanelBlueprint& blueprint, std::size_t& index,
+                                                           TemplateScope* scope, const BindingContext& context) {
+    if (index >= blueprint.node_count()) {
+        std::cerr << "Blueprint node table is truncated" << std::endl;
+        return nullptr;
+    }
+    
+    const blueprint::Node& node = blueprint.nodes()[index++];
+    auto widget = create_widget_from_node(blueprint, node, scope, context);
+    ContainerWidget* container = widget_cast<ContainerWidget>(widget.get());
+    if (container) {
+        container->reserve_children(node.child_count);
+    }
+    for (std::uint32_t child = 0; child < node.child_count; ++child) {
+        auto child_widget = build_blueprint_subtree(blueprint, index, scope, context);
+        if (container && child_widget) {
+            container->add_child(std::move(child_widget));
+        }
+    }
+    return widget;
+}
+
+void XmlParser::build_blueprint_table(TableWidget& table, const PanelBlueprint& blueprint, const blueprint::Node& node,
+                                      std::size_t& index, const BindingContext& context) {
+    std::string_view alias = blueprint.string(node.group);
+    for (std::uint32_t c = 0; c < node.child_count && index < blueprint.node_count(); ++c) {
+        const blueprint::Node& column_node = blueprint.nodes()[index++];
+        if (column_node.kind != blueprint::NodeKind::Column) {
+            std::cerr << "Blueprint table '" << table.get_id() << "' has a non-column child" << std::endl;
+            continue;
+        }
         
-        // Transfer ownership of the root widget
-        // We need to extract the widget from the new panel
-        // This is a bit tricky because we need to move ownership
-        // For now, let's rebuild the panel entirely in the calling code
-        return true;
+        TableColumn column;
+        column.header = std::string(blueprint.string(column_node.text));
+        column.kind = static_cast<TableColumn::Kind>(column_node.value);
+        column.weight = column_node.flex;
+        if (column.kind == TableColumn::Kind::Choice) {
+            TableColumn::parse_choices(blueprint.string(column_node.group), column.choices);
+        }
+        add_table_column(table, std::move(column), blueprint.string(column_node.bind), alias, context);
     }
-    return false;
+    finish_table(table, context);
+}
+
+static_assert(blueprint::kJustifyCount == static_cast<int>(Widget::Justify::SpaceEvenly) + 1);
+static_assert(blueprint::kAlignCount == static_cast<int>(Widget::Align::Baseline) + 1);
+static_assert(blueprint::kVariantCount == static_cast<int>(Widget::Variant::Header) + 1);
+static_assert(blueprint::kFontSizeCount == static_cast<int>(Widget::FontSize::Large) + 1);
+static_assert(blueprint::kColumnKindCount == static_cast<int>(TableColumn::Kind::Choice) + 1);
+
+std::unique_ptr<Widget> XmlParser::create_widget_from_node(const PanelBlueprint& blueprint, const blueprint::Node& node,
+                                                           TemplateScope* scope, const BindingContext& context) {
+    std::string id(blueprint.string(node.id));
+    std::string text(blueprint.string(node.text));
+    
+    std::unique_ptr<Widget> widget;
+    switch (node.kind) {
+    case blueprint::NodeKind::Label:
+        widget = WidgetFactory::create_label(id, text);
+        break;
+    case blueprint::NodeKind::InputText:
+        widget = WidgetFactory::create_input_text(id, nullptr);
+        break;
+    case blueprint::NodeKind::InputNumber:
+        widget = WidgetFactory::create_input_number(id);
+        break;
+    case blueprint::NodeKind::Checkbox:
+        widget = WidgetFactory::create_checkbox(id, text, nullptr);
+        break;
+    case blueprint::NodeKind::Radio:
+        widget = WidgetFactory::create_radio_button(id, text, std::string(blueprint.string(node.group)),
+                                                    node.value, nullptr);
+        break;
+    case blueprint::NodeKind::Button: {
+        auto button = WidgetFactory::create_button(id, text);
+        auto callback_it = button_callbacks_.find(id);
+        if (callback_it != button_callbacks_.end()) {
+            button->set_callback(callback_it->second);
+        }
+        widget = std::move(button);
+        break;
+    }
+    case blueprint::NodeKind::HLayout:
+        widget = WidgetFactory::create_hlayout(id);
+        break;
+    case blueprint::NodeKind::VLayout:
+        widget = WidgetFactory::create_vlayout(id);
+        break;
+    case blueprint::NodeKind::Repeat:
+        widget = std::make_unique<RepeatWidget>(id, std::string(blueprint.string(node.bind)));
+        break;
+    case blueprint::NodeKind::Table:
+        widget = std::make_unique<TableWidget>(id, std::string(blueprint.string(node.bind)));
+        break;
+    case blueprint::NodeKind::Column:
+        // Consumed by build_blueprint_table
+        return nullptr;
+    default:
+        // PanelBlueprint::attach rejects unknown kinds; never build from one
+        return nullptr;
+    }
+    
+    if (node.kind != blueprint::NodeKind::Repeat && node.kind != blueprint::NodeKind::Table) {
+        bind_or_record(*widget, blueprint.string(node.bind), scope, context);
+    }
+    
+    if (node.flags & blueprint::kHasWidth) widget->set_width(node.width);
+    if (node.flags & blueprint::kHasHeight) widget->set_height(node.height);
+    if (node.flags & blueprint::kHasFlex) widget->set_flex(node.flex);
+    
+    Widget::Style& style = widget->get_style();
+    if (node.flags & blueprint::kHasMargin) style.margin = node.margin;
+    if (node.flags & blueprint::kHasPadding) style.padding = node.padding;
+    if (node.flags & blueprint::kHasGap) style.gap = node.gap;
+    style.disabled = (node.flags & blueprint::kDisabled) != 0;
+    style.bold = (node.flags & blueprint::kBold) != 0;
+    style.stretch = (node.flags & blueprint::kStretch) != 0;
+    style.wrap = (node.flags & blueprint::kWrap) != 0;
+    style.justify = static_cast<Widget::Justify>(node.justify);
+    style.align = static_cast<Widget::Align>(node.align);
+    style.align_self = static_cast<Widget::Align>(node.align_self);
+    style.variant = static_cast<Widget::Variant>(node.variant);
+    style.font_size = static_cast<Widget::FontSize>(node.font_size);
+    style.text_color = node.text_color;
+    style.bg_color = node.bg_color;
+    
+    widget->setup_yoga_layout();
+    return widget;
 }
 
 bool XmlParser::validate_layout_hierarchy(Widget* widget, std::string& error_message) {
-    ContainerWidget* container = dynamic_cast<ContainerWidget*>(widget);
-    if (container) {
-        for (const auto& child : container->get_children()) {
-            ContainerWidget* child_container = dynamic_cast<ContainerWidget*>(child.get());
-            if (child_container) {
-                // Check for same-type nesting
-                HLayoutWidget* parent_hlayout = dynamic_cast<HLayoutWidget*>(container);
-                VLayoutWidget* parent_vlayout = dynamic_cast<VLayoutWidget*>(container);
-                HLayoutWidget* child_hlayout = dynamic_cast<HLayoutWidget*>(child.get());
-                VLayoutWidget* child_vlayout = dynamic_cast<VLayoutWidget*>(child.get());
-                
-                if ((parent_hlayout && child_hlayout) || (parent_vlayout && child_vlayout)) {
-                    error_message = "Layout container '" + container->get_id() + 
-                                   "' contains child layout '" + child->get_id() + 
-                                   "' of the same type. Consider using different layout types.";
-                    return false;
-                }
-                
-                // Recursively validate children
-                if (!validate_layout_hierarchy(child.get(), error_message)) {
-                    return false;
-                }
+    if (!widget) {
+        return true;
+    }
+    
+    // A layout directly inside a layout of the same direction adds nothing
+    bool valid = true;
+    walk_widgets(*widget, [&](Widget& node) {
+        if (!valid || !node.is_container()) {
+            return false;
+        }
+        WidgetKind kind = node.get_kind();
+        bool directional = kind == WidgetKind::HLayout || kind == WidgetKind::VLayout;
+        for (const auto& child : static_cast<ContainerWidget&>(node).get_children()) {
+            if (directional && child->get_kind() == kind) {
+                error_message = "Layout container '" + node.get_id() +
+                               "' contains child layout '" + child->get_id() +
+                               "' of the same type. Consider using different layout types.";
+                valid = false;
+                return false;
             }
         }
-    }
-    return true;
+        return true;
+    });
+    return valid;
 }
 
 // ============================================================================
@@ -439,21 +1158,24 @@ bool XmlParser::validate_layout_hierarchy(Widget* widget, std::string& error_mes
 // ============================================================================
 
 XmlFileWatcher::XmlFileWatcher(const std::string& file_path) : file_path_(file_path) {
-    last_modified_time_ = get_file_modified_time(file_path_);
+    FileWatchService::instance().subscribe(file_path_, this);
+}
+
+XmlFileWatcher::~XmlFileWatcher() {
+    FileWatchService::instance().unsubscribe(this);
 }
 
 bool XmlFileWatcher::has_changed() {
-    std::time_t current_time = get_file_modified_time(file_path_);
-    if (current_time != last_modified_time_ && current_time != 0) {
-        last_modified_time_ = current_time;
-        notify_observers();
-        return true;
+    if (!changed_) {
+        return false;
     }
-    return false;
+    changed_ = false;
+    notify_observers();
+    return true;
 }
 
 void XmlFileWatcher::reset() {
-    last_modified_time_ = get_file_modified_time(file_path_);
+    changed_ = false;
 }
 
 void XmlFileWatcher::add_observer(XmlFileObserver* observer) {
@@ -469,15 +1191,3 @@ void XmlFileWatcher::notify_observers() {
         observer->on_file_changed(file_path_);
     }
 }
-
-std::time_t XmlFileWatcher::get_file_modified_time(const std::string& file_path) {
-    try {
-        if (std::filesystem::exists(file_path)) {
-            auto ftime = std::filesystem::last_write_time(file_path);
-            return std::chrono::duration_cast<std::chrono::seconds>(ftime.time_since_epoch()).count();
-        }
-    } catch (const std::exception&) {
-        // File doesn't exist or other error
-    }
-    return 0;
-}
\ No newline at end of file
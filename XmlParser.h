@@ -2,11 +2,23 @@
 #include "Widget.h"
 #include "Panel.h"
 #include "AppData.h"
+#include "DataBinding.h"
+#include "PanelBlueprint.h"
+#include "PanelReconciler.h"
+#include "RepeatWidget.h"
+#include "TableWidget.h"
+#include "ThreadPool.h"
+#include "XmlKeywords.h"
+#include <array>
+#include <cstdint>
 #include <string>
 #include <map>
 #include <functional>
 #include <memory>
-#include <ctime>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 
@@ -14,13 +26,14 @@
  * @brief Strategy interface for handling different XML element types
  * 
  * This implements the Strategy pattern to handle parsing of different
- * XML element types in a extensible way.
+ * XML element types in a extensible way. Strategies are stateless so one
+ * instance can serve several panels being parsed concurrently.
  */
 class ElementParsingStrategy {
 public:
     virtual ~ElementParsingStrategy() = default;
-    virtual std::unique_ptr<Widget> parse(void* xml_element, AppData* app_data, 
-                                         const std::map<std::string, std::function<void()>>& callbacks) = 0;
+    virtual std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                         const std::map<std::string, std::function<void()>>& callbacks) const = 0;
 };
 
 /**
@@ -28,38 +41,67 @@ public:
  */
 class LabelParsingStrategy : public ElementParsingStrategy {
 public:
-    std::unique_ptr<Widget> parse(void* xml_element, AppData* app_data, 
-                                 const std::map<std::string, std::function<void()>>& callbacks) override;
+    std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                 const std::map<std::string, std::function<void()>>& callbacks) const override;
 };
 
 class InputParsingStrategy : public ElementParsingStrategy {
 public:
-    std::unique_ptr<Widget> parse(void* xml_element, AppData* app_data, 
-                                 const std::map<std::string, std::function<void()>>& callbacks) override;
+    std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                 const std::map<std::string, std::function<void()>>& callbacks) const override;
 };
 
 class CheckboxParsingStrategy : public ElementParsingStrategy {
 public:
-    std::unique_ptr<Widget> parse(void* xml_element, AppData* app_data, 
-                                 const std::map<std::string, std::function<void()>>& callbacks) override;
+    std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                 const std::map<std::string, std::function<void()>>& callbacks) const override;
 };
 
 class RadioParsingStrategy : public ElementParsingStrategy {
 public:
-    std::unique_ptr<Widget> parse(void* xml_element, AppData* app_data, 
-                                 const std::map<std::string, std::function<void()>>& callbacks) override;
+    std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                 const std::map<std::string, std::function<void()>>& callbacks) const override;
 };
 
 class ButtonParsingStrategy : public ElementParsingStrategy {
 public:
-    std::unique_ptr<Widget> parse(void* xml_element, AppData* app_data, 
-                                 const std::map<std::string, std::function<void()>>& callbacks) override;
+    std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                 const std::map<std::string, std::function<void()>>& callbacks) const override;
 };
 
 class LayoutParsingStrategy : public ElementParsingStrategy {
 public:
-    std::unique_ptr<Widget> parse(void* xml_element, AppData* app_data, 
-                                 const std::map<std::string, std::function<void()>>& callbacks) override;
+    std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                 const std::map<std::string, std::function<void()>>& callbacks) const override;
+};
+
+class RepeatParsingStrategy : public ElementParsingStrategy {
+public:
+    std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                 const std::map<std::string, std::function<void()>>& callbacks) const override;
+};
+
+class TableParsingStrategy : public ElementParsingStrategy {
+public:
+    std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                 const std::map<std::string, std::function<void()>>& callbacks) const override;
+};
+
+class ColumnParsingStrategy : public ElementParsingStrategy {
+public:
+    std::unique_ptr<Widget> parse(const ElementAttributes& attributes, AppData* app_data, 
+                                 const std::map<std::string, std::function<void()>>& callbacks) const override;
+};
+
+/**
+ * @brief Observer interface for XML file changes
+ * 
+ * This implements the Observer pattern to enable hot reloading of XML files.
+ */
+class XmlFileObserver {
+public:
+    virtual ~XmlFileObserver() = default;
+    virtual void on_file_changed(const std::string& file_path) = 0;
 };
 
 /**
@@ -68,8 +110,18 @@ public:
  * This class implements the Builder pattern to construct widget hierarchies
  * from XML descriptions. It uses the Strategy pattern internally to handle
  * different element types.
+ *
+ * Parsing and loading may run on several threads at once (see
+ * parse_panels_async). Button callbacks can be changed at any time; the
+ * app data and binding registry must be set before loads are started.
+ *
+ * load_panel() compiles each XML file once into a shared, immutable
+ * blueprint and builds panels from it, so opening many panels from one
+ * file costs a single parse. Cached blueprints are keyed by path and
+ * content hash; register the parser as an observer of an XmlFileWatcher
+ * to drop a file's blueprint as soon as it changes on disk.
  */
-class XmlParser {
+class XmlParser : public XmlFileObserver {
 public:
     XmlParser();
     ~XmlParser();
@@ -78,63 +130,138 @@ public:
     std::unique_ptr<Panel> parse_panel_from_file(const std::string& xml_file);
     std::unique_ptr<Widget> parse_widget_from_string(const std::string& xml_string);
     
+    // Compiled blueprints. Reading XML (here and in parse_panel_from_file)
+    // always builds the tinyxml2 DOM first; only loading an up-to-date .xmlb
+    // skips it, so memory-sensitive panels should ship compiled blueprints.
+    bool compile_panel_blueprint(const std::string& xml_file, const std::string& blueprint_file,
+                                 std::string& error_message);
+    std::unique_ptr<Panel> load_panel_blueprint(const std::string& blueprint_file);
+    std::unique_ptr<Panel> load_panel(const std::string& xml_file);
+    static std::string blueprint_path_for(const std::string& xml_file);
+    
+    // Blueprint cache: the blueprint for an XML file, compiled on first use
+    // (or mapped from an up-to-date .xmlb) and shared until invalidated
+    std::shared_ptr<const PanelBlueprint> get_blueprint(const std::string& xml_file);
+    std::unique_ptr<Panel> instantiate(const PanelBlueprint& blueprint, const BindingContext& context = {});
+    void invalidate_blueprint(const std::string& xml_file);
+    void clear_blueprint_cache();
+    void on_file_changed(const std::string& file_path) override { invalidate_blueprint(file_path); }
+    
+    // Parallel loading: each file is loaded with load_panel on a pool worker.
+    // The parser must outlive the returned futures; add the panels to the
+    // PanelManager on the UI thread.
+    std::vector<std::future<std::unique_ptr<Panel>>> parse_panels_async(
+        const std::vector<std::string>& xml_files, ThreadPool& pool = ThreadPool::instance());
+    
     // Data binding
     void set_app_data(AppData* data) { app_data_ = data; }
     AppData* get_app_data() const { return app_data_; }
+    void set_binding_registry(const BindingRegistry& registry) { binding_registry_ = &registry; }
     
     // Callback management
     void add_button_callback(const std::string& id, std::function<void()> callback);
     void remove_button_callback(const std::string& id);
     void clear_callbacks();
     
-    // Hot reload support
-    bool reload_panel(Panel& panel, const std::string& xml_file);
+    // Hot reload support: re-parses the file and patches the live panel in place
+    bool reload_panel(Panel& panel, const std::string& xml_file, ReconcileStats* stats = nullptr);
+    
+    // Background hot reload: builds a replacement for `live` on a pool worker,
+    // at its DPI scale and laid out for its current content size, ready for
+    // PanelManager::swap_panel_when_ready, which replaces the live panel whole.
+    // `live` is only read on this thread.
+    std::future<std::unique_ptr<Panel>> reload_panel_async(const Panel& live, const std::string& xml_file,
+                                                           ThreadPool& pool = ThreadPool::instance());
     
     // Validation
     bool validate_xml_file(const std::string& xml_file, std::string& error_message);
     
+    // Rejects layouts nested directly in a layout of the same direction
+    static bool validate_layout_hierarchy(Widget* widget, std::string& error_message);
+    
 private:
     AppData* app_data_ = nullptr;
+    const BindingRegistry* binding_registry_ = &BindingRegistry::app_data();
     std::map<std::string, std::function<void()>> button_callbacks_;
-    std::map<std::string, std::unique_ptr<ElementParsingStrategy>> strategies_;
+    mutable std::shared_mutex callbacks_mutex_;  // shared while building, exclusive while editing
+    std::array<std::unique_ptr<ElementParsingStrategy>, xml_keywords::kElementCount> strategies_;
+    
+    // A stale entry is revalidated by content hash before it is recompiled
+    struct CachedBlueprint {
+        std::uint64_t content_hash = 0;
+        std::shared_ptr<const PanelBlueprint> blueprint;
+        bool stale = false;
+    };
+    std::mutex blueprint_cache_mutex_;
+    std::unordered_map<std::string, CachedBlueprint> blueprint_cache_;
+    
+    /**
+     * @brief Collects the bindings of a <repeat> row template while it is parsed
+     * 
+     * Widgets are numbered in pre-order as they are built; bind paths starting
+     * with the row alias are compiled against the source collection instead of
+     * being resolved.
+     */
+    struct TemplateScope {
+        std::string_view alias;
+        std::string_view source;
+        std::size_t next_index = 0;
+        std::vector<TemplateBinding> bindings;
+    };
     
     // Helper methods
-    std::unique_ptr<Widget> parse_element(void* xml_element);
-    void apply_properties_to_widget(Widget& widget, void* xml_element);
-    void apply_style_properties(Widget::Style& style, void* xml_element);
-    std::string get_attribute(void* xml_element, const std::string& name, const std::string& default_value = "");
+    std::unique_ptr<Widget> parse_element(void* xml_element, TemplateScope* scope = nullptr);
+    std::unique_ptr<Widget> build_widget(void* xml_element, TemplateScope* scope = nullptr);
+    void build_repeat(RepeatWidget& repeat, void* xml_element, const TemplateScope* scope);
+    void finish_repeat(RepeatWidget& repeat, std::unique_ptr<Widget> prototype, TemplateScope& row_scope,
+                       const BindingContext& context = {});
+    void build_table(TableWidget& table, void* xml_element);
+    void add_table_column(TableWidget& table, TableColumn column, std::string_view bind_path, std::string_view alias,
+                          const BindingContext& context = {});
+    void finish_table(TableWidget& table, const BindingContext& context = {});
+    void apply_properties_to_widget(Widget& widget, const ElementAttributes& attributes);
+    void apply_style_properties(Widget::Style& style, const ElementAttributes& attributes);
+    std::unique_ptr<ElementParsingStrategy>& strategy_for(XmlElementType type) {
+        return strategies_[static_cast<std::size_t>(type)];
+    }
+    
+    // Blueprint helpers
+    bool compile_panel_element(void* panel_element, PanelBlueprintWriter& writer, std::string& error_message);
+    bool compile_element(void* xml_element, PanelBlueprintWriter& writer, std::string& error_message,
+                         bool in_template = false);
+    std::shared_ptr<const PanelBlueprint> compile_blueprint(const std::string& xml_file, const std::string& source);
+    std::unique_ptr<Widget> build_blueprint_subtree(const PanelBlueprint& blueprint, std::size_t& index,
+                                                    TemplateScope* scope, const BindingContext& context);
+    void build_blueprint_table(TableWidget& table, const PanelBlueprint& blueprint, const blueprint::Node& node,
+                               std::size_t& index, const BindingContext& context);
+    std::unique_ptr<Widget> create_widget_from_node(const PanelBlueprint& blueprint, const blueprint::Node& node,
+                                                    TemplateScope* scope, const BindingContext& context);
+    static std::string blueprint_cache_key(const std::string& xml_file);
     
     // Data binding helpers
-    std::string* bind_string_field(const std::string& bind_expression);
-    bool* bind_bool_field(const std::string& bind_expression);
-    float* bind_float_field(const std::string& bind_expression);
-    int* bind_int_field(const std::string& bind_expression);
+    void apply_binding(Widget& widget, std::string_view bind_path, const BindingContext& context = {});
+    void bind_or_record(Widget& widget, std::string_view bind_path, TemplateScope* scope,
+                        const BindingContext& context = {});
     
     // Validation helpers
-    bool validate_layout_hierarchy(Widget* widget, std::string& error_message);
     bool can_add_child(Widget* parent, Widget* child, std::string& error_message);
 };
 
-/**
- * @brief Observer interface for XML file changes
- * 
- * This implements the Observer pattern to enable hot reloading of XML files.
- */
-class XmlFileObserver {
-public:
-    virtual ~XmlFileObserver() = default;
-    virtual void on_file_changed(const std::string& file_path) = 0;
-};
-
 /**
  * @brief File watcher for hot reload functionality
  * 
- * Monitors XML files for changes and notifies observers when files are modified.
+ * Monitors an XML file for changes and notifies observers when it is modified.
+ * Detection runs on the FileWatchService thread; has_changed() only reports
+ * what the last FileWatchService::poll() delivered and never touches the
+ * filesystem.
  */
 class XmlFileWatcher {
 public:
     explicit XmlFileWatcher(const std::string& file_path);
-    ~XmlFileWatcher() = default;
+    ~XmlFileWatcher();
+    
+    XmlFileWatcher(const XmlFileWatcher&) = delete;
+    XmlFileWatcher& operator=(const XmlFileWatcher&) = delete;
     
     bool has_changed();
     void reset();
@@ -142,11 +269,15 @@ public:
     void add_observer(XmlFileObserver* observer);
     void remove_observer(XmlFileObserver* observer);
     
+    const std::string& get_file_path() const { return file_path_; }
+    
 private:
+    friend class FileWatchService;
+    
     std::string file_path_;
-    std::time_t last_modified_time_;
+    bool changed_ = false;
     std::vector<XmlFileObserver*> observers_;
     
+    void mark_changed() { changed_ = true; }
     void notify_observers();
-    std::time_t get_file_modified_time(const std::string& file_path);
 };
@@ -0,0 +1,75 @@
+#pragma once
+#include "Widget.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Helpers shared by the headless benchmark executables
+ */
+namespace bench {
+
+constexpr int kRuns = 5;
+
+// Best wall time of kRuns calls to fn, in milliseconds
+template <typename Fn>
+double best_of(Fn&& fn) {
+    double best = 1e30;
+    for (int run = 0; run < kRuns; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// Values a generated row binds to
+struct RowData {
+    std::string city;
+    float values[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    bool enabled = true;
+    int climate = 0;
+};
+
+/**
+ * @brief Column of `rows` city rows, 13 widgets each
+ *
+ * Each row holds a label, text and number inputs, a checkbox, a radio
+ * button, a nested column of two labels and a button. Inputs are bound to
+ * the matching element of `data` when given (it must hold `rows` entries),
+ * and left unbound otherwise.
+ */
+inline std::unique_ptr<Widget> generate_tree(int rows, std::vector<RowData>* data = nullptr) {
+    auto root = WidgetFactory::create_vlayout("root");
+    for (int i = 0; i < rows; ++i) {
+        const std::string idx = std::to_string(i);
+        RowData* row_data = data ? &(*data)[static_cast<std::size_t>(i)] : nullptr;
+        auto row = WidgetFactory::create_hlayout("row_" + idx);
+        row->add_child(WidgetFactory::create_label("label_" + idx, "Row " + idx));
+        row->add_child(WidgetFactory::create_input_text("city_" + idx, row_data ? &row_data->city : nullptr));
+        int field_index = 0;
+        for (const char* field : {"lat_", "lon_", "elev_", "temp_"}) {
+            auto input = WidgetFactory::create_input_number(field + idx);
+            if (row_data) {
+                input->bind_float_value(&row_data->values[field_index]);
+            }
+            ++field_index;
+            row->add_child(std::move(input));
+        }
+        row->add_child(WidgetFactory::create_checkbox("check_" + idx, "On", row_data ? &row_data->enabled : nullptr));
+        row->add_child(WidgetFactory::create_radio_button("radio_" + idx, "Arid", "g_" + idx, 2,
+                                                          row_data ? &row_data->climate : nullptr));
+        auto column = WidgetFactory::create_vlayout("notes_" + idx);
+        column->add_child(WidgetFactory::create_label("note_a_" + idx, "A"));
+        column->add_child(WidgetFactory::create_label("note_b_" + idx, "B"));
+        row->add_child(std::move(column));
+        row->add_child(WidgetFactory::create_button("btn_" + idx, "Go"));
+        root->add_child(std::move(row));
+    }
+    return root;
+}
+
+} // namespace bench
@@ -162,7 +162,7 @@ std::unique_ptr<Panel> BuilderApplication::build_city_panel() {
 CityDataPanelBuilder builder(app_data_);
     builder.with_title("City Data Grid")
         .with_size(1100.0f, 680.0f)
-        .with_max_rows(6)
+        .with_min_rows(6)
         .on_save([this]() {
             std::cout << "City data saved:" << std::endl;
             for (std::size_t i = 0; i < std::min<std::size_t>(app_data_.cities.size(), 6); ++i) {
@@ -204,17 +204,20 @@ void BuilderApplication::render_menu_bar() {
         }
 
         auto [yoga_ms, yoga_peak_ms] = PanelManager::instance().get_layout_durations();
+        Panel::LayoutStats layout_stats = PanelManager::instance().get_layout_stats();
         ImVec2 region_max = ImGui::GetWindowContentRegionMax();
         ImVec2 region_min = ImGui::GetWindowContentRegionMin();
         float region_width = region_max.x - region_min.x;
-        float text_width = ImGui::CalcTextSize("Yoga Δ 000.000 ms | peak 000.000 ms").x;
+        float text_width =
+            ImGui::CalcTextSize("Yoga Δ 000.000 ms | peak 000.000 ms | 0000 laid out, 0000 cached, 0000 restored").x;
         float cursor_x = region_min.x + region_width - text_width - 10.0f;
         if (cursor_x > ImGui::GetCursorPosX()) {
             ImGui::SameLine(cursor_x);
         } else {
             ImGui::SameLine();
         }
-        ImGui::Text("Yoga Δ %.3f ms | peak %.3f ms", yoga_ms, yoga_peak_ms);
+        ImGui::Text("Yoga Δ %.3f ms | peak %.3f ms | %zu laid out, %zu cached, %zu restored", yoga_ms,
+                    yoga_peak_ms, layout_stats.laid_out, layout_stats.reused, layout_stats.restored);
         ImGui::EndMainMenuBar();
     }
 }
@@ -263,8 +266,8 @@ void BuilderApplication::apply_dpi_scale(float scale) {
     style = base_style_;
     style.ScaleAllSizes(dpi_scale_);
 
+    // Panels lay out once on their next render
     PanelManager::instance().set_all_dpi_scale(dpi_scale_);
-    PanelManager::instance().update_all_layouts();
 }
 
 int main() {
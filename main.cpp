@@ -5,8 +5,28 @@
 #include "Widget.h"
 #include "Panel.h"
 #include "XmlParser.h"
+#include "FileWatchService.h"
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief XML panels of the application
+ *
+ * Panels that start open are loaded at startup; the others are parsed and
+ * built the first time they are shown.
+ */
+struct PanelSource {
+    const char* name;
+    const char* xml_file;
+    bool start_open;
+};
+
+static const PanelSource kPanelSources[] = {
+    {"contact", "contact_panel.xml", false},
+    {"city_data", "city_data_panel.xml", true},
+};
 
 /**
  * @brief Application class implementing the Facade pattern
@@ -40,6 +60,8 @@ private:
     void setup_file_watchers();
     void render_menu_bar();
     void handle_keyboard_shortcuts();
+    void reload_panel(const std::string& name, const std::string& xml_file);
+    void reload_panel_in_background(const std::string& name, const std::string& xml_file);
 };
 
 bool Application::initialize() {
@@ -78,19 +100,29 @@ bool Application::initialize() {
     initialize_app_data();
     setup_button_callbacks();
     
-    // Load panels
+    // Load open panels in parallel; only registration happens on the UI thread
     parser_->set_app_data(&app_data_);
     
-    auto contact_panel = parser_->parse_panel_from_file("contact_panel.xml");
-    if (contact_panel) {
-        contact_panel->set_open(false); // Start closed
-        PanelManager::instance().add_panel("contact", std::move(contact_panel));
+    std::vector<std::string> xml_files;
+    std::vector<const PanelSource*> eager_sources;
+    for (const auto& source : kPanelSources) {
+        if (source.start_open) {
+            xml_files.push_back(source.xml_file);
+            eager_sources.push_back(&source);
+        } else {
+            std::string xml_file = source.xml_file;
+            PanelManager::instance().add_deferred_panel(source.name, [this, xml_file]() {
+                return parser_->load_panel(xml_file);
+            });
+        }
     }
     
-    auto city_panel = parser_->parse_panel_from_file("city_data_panel.xml");
-    if (city_panel) {
-        city_panel->set_open(true); // Start open
-        PanelManager::instance().add_panel("city_data", std::move(city_panel));
+    auto panels = parser_->parse_panels_async(xml_files);
+    for (size_t i = 0; i < panels.size(); ++i) {
+        auto panel = panels[i].get();
+        if (panel) {
+            PanelManager::instance().add_panel(eager_sources[i]->name, std::move(panel));
+        }
     }
     
     setup_file_watchers();
@@ -110,27 +142,21 @@ void Application::run() {
                 done_ = true;
         }
 
-        // Check for file changes
+        // Deliver file changes detected by the watch thread since the last frame
+        FileWatchService::instance().poll();
         if (contact_watcher_ && contact_watcher_->has_changed()) {
             std::cout << "Contact XML file changed, reloading..." << std::endl;
-            auto new_panel = parser_->parse_panel_from_file("contact_panel.xml");
-            if (new_panel) {
-                bool was_open = PanelManager::instance().get_panel("contact")->is_open();
-                new_panel->set_open(was_open);
-                PanelManager::instance().add_panel("contact", std::move(new_panel));
-                std::cout << "Contact panel reloaded successfully!" << std::endl;
-            }
+            reload_panel_in_background("contact", "contact_panel.xml");
         }
         
         if (city_watcher_ && city_watcher_->has_changed()) {
             std::cout << "City XML file changed, reloading..." << std::endl;
-            auto new_panel = parser_->parse_panel_from_file("city_data_panel.xml");
-            if (new_panel) {
-                bool was_open = PanelManager::instance().get_panel("city_data")->is_open();
-                new_panel->set_open(was_open);
-                PanelManager::instance().add_panel("city_data", std::move(new_panel));
-                std::cout << "City panel reloaded successfully!" << std::endl;
-            }
+            reload_panel_in_background("city_data", "city_data_panel.xml");
+        }
+        
+        // Apply panels finished by background reloads before this frame uses them
+        if (std::size_t swapped = PanelManager::instance().apply_pending_swaps()) {
+            std::cout << swapped << " panel(s) reloaded in the background" << std::endl;
         }
 
         // Start the Dear ImGui frame
@@ -159,6 +185,9 @@ void Application::run() {
 }
 
 void Application::shutdown() {
+    // Background reloads use the parser, so let them finish first
+    PanelManager::instance().wait_pending_swaps();
+    
     ImGui_ImplSDLRenderer2_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
@@ -219,6 +248,9 @@ void Application::setup_file_watchers() {
     contact_watcher_ = std::make_unique<XmlFileWatcher>("contact_panel.xml");
     city_watcher_ = std::make_unique<XmlFileWatcher>("city_data_panel.xml");
     
+    // The parser drops its cached blueprint before the application reloads
+    contact_watcher_->add_observer(parser_.get());
+    city_watcher_->add_observer(parser_.get());
     contact_watcher_->add_observer(this);
     city_watcher_->add_observer(this);
 }
@@ -244,22 +276,10 @@ void Application::render_menu_bar() {
         
         if (ImGui::BeginMenu("Reload")) {
             if (ImGui::MenuItem("Reload Contact Panel", "Ctrl+R")) {
-                auto new_panel = parser_->parse_panel_from_file("contact_panel.xml");
-                if (new_panel) {
-                    bool was_open = PanelManager::instance().get_panel("contact")->is_open();
-                    new_panel->set_open(was_open);
-                    PanelManager::instance().add_panel("contact", std::move(new_panel));
-                    std::cout << "Contact panel manually reloaded!" << std::endl;
-                }
+                reload_panel("contact", "contact_panel.xml");
             }
             if (ImGui::MenuItem("Reload City Panel", "Ctrl+Shift+R")) {
-                auto new_panel = parser_->parse_panel_from_file("city_data_panel.xml");
-                if (new_panel) {
-                    bool was_open = PanelManager::instance().get_panel("city_data")->is_open();
-                    new_panel->set_open(was_open);
-                    PanelManager::instance().add_panel("city_data", std::move(new_panel));
-                    std::cout << "City panel manually reloaded!" << std::endl;
-                }
+                reload_panel("city_data", "city_data_panel.xml");
             }
             ImGui::Separator();
             if (ImGui::MenuItem("Reset File Watchers")) {
@@ -275,24 +295,52 @@ void Application::render_menu_bar() {
 
 void Application::handle_keyboard_shortcuts() {
     if (ImGui::IsKeyPressed(ImGuiKey_R) && ImGui::GetIO().KeyCtrl && !ImGui::GetIO().KeyShift) {
-        auto new_panel = parser_->parse_panel_from_file("contact_panel.xml");
-        if (new_panel) {
-            bool was_open = PanelManager::instance().get_panel("contact")->is_open();
-            new_panel->set_open(was_open);
-            PanelManager::instance().add_panel("contact", std::move(new_panel));
-            std::cout << "Contact panel reloaded via keyboard shortcut!" << std::endl;
-        }
+        reload_panel("contact", "contact_panel.xml");
     }
     
     if (ImGui::IsKeyPressed(ImGuiKey_R) && ImGui::GetIO().KeyCtrl && ImGui::GetIO().KeyShift) {
-        auto new_panel = parser_->parse_panel_from_file("city_data_panel.xml");
+        reload_panel("city_data", "city_data_panel.xml");
+    }
+}
+
+void Application::reload_panel(const std::string& name, const std::string& xml_file) {
+    if (PanelManager::instance().is_panel_deferred(name)) {
+        // Not built yet; it reads the current file when first shown
+        PanelManager::instance().refresh_deferred_panel(name);
+        return;
+    }
+    
+    Panel* panel = PanelManager::instance().get_panel(name);
+    if (!panel) {
+        // Nothing to patch yet, build it from scratch
+        auto new_panel = parser_->parse_panel_from_file(xml_file);
         if (new_panel) {
-            bool was_open = PanelManager::instance().get_panel("city_data")->is_open();
-            new_panel->set_open(was_open);
-            PanelManager::instance().add_panel("city_data", std::move(new_panel));
-            std::cout << "City panel reloaded via keyboard shortcut!" << std::endl;
+            PanelManager::instance().add_panel(name, std::move(new_panel));
         }
+        return;
     }
+    
+    // Patch the live panel in place so unchanged widgets keep their state
+    ReconcileStats stats;
+    if (parser_->reload_panel(*panel, xml_file, &stats)) {
+        std::cout << "Reloaded " << name << " panel: " << stats.unchanged << " unchanged, "
+                  << stats.patched << " patched, " << stats.created << " created, "
+                  << stats.removed << " removed" << std::endl;
+    }
+}
+
+void Application::reload_panel_in_background(const std::string& name, const std::string& xml_file) {
+    if (PanelManager::instance().is_panel_deferred(name)) {
+        PanelManager::instance().refresh_deferred_panel(name);
+        return;
+    }
+    
+    // Parsing, building and layout happen on a worker; the frame loop only swaps the panel
+    Panel* live = PanelManager::instance().get_panel(name);
+    std::future<std::unique_ptr<Panel>> panel = live
+        ? parser_->reload_panel_async(*live, xml_file)
+        : std::move(parser_->parse_panels_async({xml_file}).front());
+    PanelManager::instance().swap_panel_when_ready(name, std::move(panel));
 }
 
 int main(int argc, char* argv[]) {
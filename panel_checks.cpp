@@ -0,0 +1,141 @@
+#include "imgui.h"
+#include "bench_common.h"
+#include "Panel.h"
+#include <array>
+#include <cstdio>
+#include <vector>
+
+/**
+ * @brief Headless behaviour checks for panels
+ *
+ * Runs a panel through headless ImGui frames and checks properties that
+ * are easy to lose without noticing on screen. Prints one line per check
+ * and exits non-zero if any failed; registered with CTest.
+ *
+ * Usage: panel_checks
+ */
+
+namespace {
+
+constexpr int kFramesPerStep = 3;
+
+struct FrameLayouts {
+    std::size_t laid_out = 0;
+    std::size_t restored = 0;
+};
+
+// Headless frames; sums the stats of the layout passes they ran
+FrameLayouts render_frames(Panel& panel, int frames) {
+    FrameLayouts layouts;
+    for (int frame = 0; frame < frames; ++frame) {
+        std::uint64_t passes = panel.get_layout_pass_count();
+        ImGui::NewFrame();
+        panel.render();
+        ImGui::Render();
+        if (panel.get_layout_pass_count() != passes) {
+            layouts.laid_out += panel.get_last_layout_stats().laid_out;
+            layouts.restored += panel.get_last_layout_stats().restored;
+        }
+    }
+    return layouts;
+}
+
+// As builder_main's DPI toggle: global font scale, truncating style scale, panel scale
+void apply_dpi_scale(Panel& panel, const ImGuiStyle& base_style, float scale) {
+    ImGui::GetIO().FontGlobalScale = scale;
+    ImGuiStyle& style = ImGui::GetStyle();
+    style = base_style;
+    style.ScaleAllSizes(scale);
+    panel.set_dpi_scale(scale);
+}
+
+// Toggling back to a DPI scale seen before restores its layout without running Yoga
+bool check_dpi_toggle_restores_layout() {
+    std::vector<bench::RowData> data(5);
+    Panel panel("Checks", 900.0f, 600.0f);
+    panel.set_root_widget(bench::generate_tree(static_cast<int>(data.size()), &data));
+    const ImGuiStyle base_style = ImGui::GetStyle();
+
+    for (float scale : {1.0f, 1.5f, 2.0f}) {
+        apply_dpi_scale(panel, base_style, scale);
+        render_frames(panel, kFramesPerStep);
+    }
+
+    bool passed = true;
+    for (float scale : {1.5f, 1.0f, 2.0f}) {
+        apply_dpi_scale(panel, base_style, scale);
+        FrameLayouts layouts = render_frames(panel, kFramesPerStep);
+        if (layouts.laid_out != 0 || layouts.restored == 0) {
+            std::printf("  back to %.1fx: %zu laid out, %zu restored\n", scale, layouts.laid_out, layouts.restored);
+            passed = false;
+        }
+    }
+
+    ImGui::GetStyle() = base_style;
+    ImGui::GetIO().FontGlobalScale = 1.0f;
+    return passed;
+}
+
+// Removing the widget that owns a duplicated id makes the remaining one findable again
+bool check_duplicate_ids_survive_removal() {
+    Panel panel("Checks", 400.0f, 300.0f);
+    auto root = WidgetFactory::create_vlayout("root");
+    for (const char* holder : {"first", "second"}) {
+        auto column = WidgetFactory::create_vlayout(holder);
+        column->add_child(WidgetFactory::create_label("dup", holder));
+        root->add_child(std::move(column));
+    }
+    auto* root_container = static_cast<ContainerWidget*>(root.get());
+    panel.set_root_widget(std::move(root));
+
+    bool passed = true;
+    auto expect = [&](const char* step, const char* text) {
+        auto* label = panel.find_widget_as<LabelWidget>("dup");
+        const char* found = label ? label->get_text().c_str() : "nothing";
+        if (!text ? label != nullptr : !label || label->get_text() != text) {
+            std::printf("  %s: found %s, expected %s\n", step, found, text ? text : "nothing");
+            passed = false;
+        }
+    };
+
+    expect("both registered", "second");
+    root_container->remove_child("second");
+    expect("last registered removed", "first");
+    root_container->remove_child("first");
+    expect("both removed", nullptr);
+    return passed;
+}
+
+struct Check {
+    const char* name;
+    bool (*run)();
+};
+
+constexpr std::array kChecks = {
+    Check{"DPI toggle restores recorded layouts", &check_dpi_toggle_restores_layout},
+    Check{"Duplicate ids stay findable after removal", &check_duplicate_ids_survive_removal},
+};
+
+} // namespace
+
+int main() {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels = nullptr;
+    int atlas_width = 0;
+    int atlas_height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &atlas_width, &atlas_height);
+
+    int failures = 0;
+    for (const Check& check : kChecks) {
+        bool passed = check.run();
+        std::printf("%s  %s\n", passed ? "PASS" : "FAIL", check.name);
+        failures += passed ? 0 : 1;
+    }
+
+    ImGui::DestroyContext();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,33 @@
+#include "XmlParser.h"
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Offline compiler that turns panel XML files into binary blueprints
+ *
+ * Usage: imgui_panel_compiler <panel.xml> [more.xml ...]
+ * Each blueprint is written next to its source with a .xmlb extension, which
+ * is where XmlParser::load_panel looks for it.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <panel.xml> [more.xml ...]" << std::endl;
+        return 1;
+    }
+    
+    XmlParser parser;
+    int failures = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string xml_file = argv[i];
+        std::string blueprint_file = XmlParser::blueprint_path_for(xml_file);
+        std::string error_message;
+        if (parser.compile_panel_blueprint(xml_file, blueprint_file, error_message)) {
+            std::cout << xml_file << " -> " << blueprint_file << std::endl;
+        } else {
+            std::cerr << xml_file << ": " << error_message << std::endl;
+            ++failures;
+        }
+    }
+    
+    return failures == 0 ? 0 : 1;
+}
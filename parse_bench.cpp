@@ -0,0 +1,173 @@
+#include "imgui.h"
+#include "bench_common.h"
+#include "XmlKeywords.h"
+#include "XmlParser.h"
+#include <tinyxml2.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+
+/**
+ * @brief Parse micro-benchmark on a generated 100k-element panel
+ *
+ * Compares the element/attribute decoding used before the perfect-hash
+ * dispatch (std::map strategy lookup, one Attribute() walk per known
+ * attribute, std::stof) with the single-pass dispatch in XmlParser, then
+ * times the full XML and blueprint load paths.
+ *
+ * Usage: xml_parse_bench [rows]   (default 10000 rows, ~100k elements)
+ */
+
+using namespace tinyxml2;
+
+namespace {
+
+std::string generate_panel(int rows) {
+    std::string xml = "<panel title=\"Bench\" width=\"900\" height=\"600\">\n<vlayout id=\"root\" padding=\"10\" gap=\"4\">\n";
+    for (int i = 0; i < rows; ++i) {
+        const std::string idx = std::to_string(i);
+        xml += "<hlayout id=\"row_" + idx + "\" justify=\"space-between\" align=\"center\" gap=\"10\">";
+        xml += "<label id=\"label_" + idx + "\" text=\"Row " + idx + "\" width=\"80\" font-size=\"small\" bold=\"true\"/>";
+        xml += "<input id=\"city_" + idx + "\" type=\"text\" bind=\"cities[" + idx + "].name\" flex=\"2\"/>";
+        xml += "<input id=\"lat_" + idx + "\" type=\"number\" bind=\"cities[" + idx + "].latitude\" flex=\"1\"/>";
+        xml += "<input id=\"lon_" + idx + "\" type=\"number\" bind=\"cities[" + idx + "].longitude\" flex=\"1\"/>";
+        xml += "<input id=\"elev_" + idx + "\" type=\"number\" bind=\"cities[" + idx + "].elevation\" flex=\"1\"/>";
+        xml += "<input id=\"temp_" + idx + "\" type=\"number\" bind=\"cities[" + idx + "].avg_temp\" flex=\"1\"/>";
+        xml += "<checkbox id=\"check_" + idx + "\" text=\"On\" bind=\"python\" margin=\"2\"/>";
+        xml += "<radio id=\"radio_" + idx + "\" text=\"Arid\" group=\"g_" + idx + "\" value=\"2\" bind=\"cities[" + idx + "].climate_zone\"/>";
+        xml += "<button id=\"btn_" + idx + "\" text=\"Go\" variant=\"primary\" padding=\"4\"/>";
+        xml += "</hlayout>\n";
+    }
+    xml += "</vlayout>\n</panel>\n";
+    return xml;
+}
+
+void for_each_element(const XMLElement* element, const std::function<void(const XMLElement&)>& fn) {
+    for (; element; element = element->NextSiblingElement()) {
+        fn(*element);
+        for_each_element(element->FirstChildElement(), fn);
+    }
+}
+
+// Decoding as done before: map lookup by element name, Attribute() per known name, std::stof
+float decode_legacy(const XMLElement& element, const std::map<std::string, int>& element_types) {
+    static const char* const kStringAttributes[] = {
+        "id", "text", "type", "bind", "group", "value", "justify", "align", "align-self",
+        "disabled", "variant", "font-size", "bold", "text-color", "bg-color", "stretch", "wrap",
+    };
+    static const char* const kNumericAttributes[] = {"width", "height", "flex", "margin", "padding", "gap"};
+
+    float sink = 0.0f;
+    auto type_it = element_types.find(element.Name());
+    if (type_it != element_types.end()) {
+        sink += static_cast<float>(type_it->second);
+    }
+    for (const char* name : kStringAttributes) {
+        const char* attr = element.Attribute(name);
+        std::string value = attr ? std::string(attr) : std::string();
+        sink += static_cast<float>(value.size());
+    }
+    for (const char* name : kNumericAttributes) {
+        const char* attr = element.Attribute(name);
+        std::string value = attr ? std::string(attr) : std::string();
+        if (!value.empty()) {
+            sink += std::stof(value);
+        }
+    }
+    return sink;
+}
+
+// Decoding as done by XmlParser: perfect-hash lookups over one attribute pass, std::from_chars
+float decode_perfect_hash(const XMLElement& element) {
+    float sink = static_cast<float>(xml_keywords::elements.find(element.Name()));
+    for (const XMLAttribute* attribute = element.FirstAttribute(); attribute; attribute = attribute->Next()) {
+        XmlAttribute key = xml_keywords::attributes.find(attribute->Name());
+        switch (key) {
+        case XmlAttribute::Width:
+        case XmlAttribute::Height:
+        case XmlAttribute::Flex:
+        case XmlAttribute::Margin:
+        case XmlAttribute::Padding:
+        case XmlAttribute::Gap: {
+            float value = 0.0f;
+            if (xml_keywords::parse_number(attribute->Value(), value)) {
+                sink += value;
+            }
+            break;
+        }
+        case XmlAttribute::Unknown:
+            break;
+        default:
+            sink += static_cast<float>(std::char_traits<char>::length(attribute->Value()));
+            break;
+        }
+    }
+    return sink;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rows = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10000;
+
+    // Widgets read ImGui IO while styling, so a headless context is enough
+    ImGui::CreateContext();
+
+    const std::string xml = generate_panel(rows);
+    const std::filesystem::path xml_path = std::filesystem::temp_directory_path() / "xml_parse_bench.xml";
+    const std::string blueprint_path = XmlParser::blueprint_path_for(xml_path.string());
+    std::ofstream(xml_path) << xml;
+
+    XMLDocument doc;
+    doc.Parse(xml.c_str(), xml.size());
+    const XMLElement* root = doc.FirstChildElement("panel")->FirstChildElement();
+
+    std::size_t element_count = 0;
+    for_each_element(root, [&](const XMLElement&) { ++element_count; });
+    std::printf("Generated panel: %d rows, %zu elements\n\n", rows, element_count);
+
+    const std::map<std::string, int> element_types = {
+        {"label", 0}, {"input", 1}, {"checkbox", 2}, {"radio", 3}, {"button", 4}, {"hlayout", 5}, {"vlayout", 6},
+    };
+
+    volatile float sink = 0.0f;
+    double legacy_ms = bench::best_of([&] {
+        for_each_element(root, [&](const XMLElement& e) { sink = sink + decode_legacy(e, element_types); });
+    });
+    double hashed_ms = bench::best_of([&] {
+        for_each_element(root, [&](const XMLElement& e) { sink = sink + decode_perfect_hash(e); });
+    });
+
+    std::printf("Attribute decode (map + Attribute() per name + stof): %8.2f ms\n", legacy_ms);
+    std::printf("Attribute decode (perfect hash, one pass, from_chars): %8.2f ms  (%.1fx)\n\n",
+                hashed_ms, legacy_ms / hashed_ms);
+
+    AppData app_data;
+    app_data.cities.resize(static_cast<std::size_t>(rows));
+    XmlParser parser;
+    parser.set_app_data(&app_data);
+
+    std::string error_message;
+    if (!parser.compile_panel_blueprint(xml_path.string(), blueprint_path, error_message)) {
+        std::fprintf(stderr, "Blueprint compile failed: %s\n", error_message.c_str());
+    }
+
+    double dom_ms = bench::best_of([&] { parser.parse_panel_from_file(xml_path.string()); });
+    double blueprint_ms = bench::best_of([&] { parser.load_panel_blueprint(blueprint_path); });
+    auto cached = parser.get_blueprint(xml_path.string());
+    double instantiate_ms = cached ? bench::best_of([&] { parser.instantiate(*cached); }) : 0.0;
+
+    std::printf("Full load, parse_panel_from_file:  %8.2f ms\n", dom_ms);
+    std::printf("Full load, load_panel_blueprint:   %8.2f ms\n", blueprint_ms);
+    std::printf("Instantiate cached blueprint:      %8.2f ms\n", instantiate_ms);
+
+    std::filesystem::remove(xml_path);
+    std::filesystem::remove(blueprint_path);
+    ImGui::DestroyContext();
+    return 0;
+}
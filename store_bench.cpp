@@ -0,0 +1,98 @@
+#include "imgui.h"
+#include "bench_common.h"
+#include "Panel.h"
+#include "WidgetStore.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Render backend benchmark on a generated panel
+ *
+ * Renders the same panel through headless ImGui frames with each
+ * Panel::Storage backend, in flow and in positioned mode, and reports the
+ * best per-frame time of each. The first frames of every run (layout and
+ * store build) are excluded; the build is timed on its own. Vertex counts
+ * are printed so the two backends can be checked to draw the same thing.
+ *
+ * Usage: widget_store_bench [rows]   (default 2000 rows, ~26k widgets)
+ */
+
+namespace {
+
+constexpr int kFrames = 20;
+constexpr int kWarmupFrames = 3;
+
+// One headless ImGui frame; returns the vertices it produced
+int render_frame(Panel& panel) {
+    ImGui::NewFrame();
+    panel.render();
+    ImGui::Render();
+    return ImGui::GetDrawData()->TotalVtxCount;
+}
+
+struct Result {
+    double frame_ms = 0.0;
+    int vertices = 0;
+};
+
+Result run(Panel& panel, Panel::Storage storage, bool positioned) {
+    panel.set_storage(storage);
+    panel.set_positioned(positioned);
+
+    Result result;
+    for (int frame = 0; frame < kWarmupFrames; ++frame) {
+        result.vertices = render_frame(panel);
+    }
+    result.frame_ms = bench::best_of([&] {
+        for (int frame = 0; frame < kFrames; ++frame) {
+            render_frame(panel);
+        }
+    }) / kFrames;
+    return result;
+}
+
+void report(const char* mode, const Result& objects, const Result& store) {
+    std::printf("%-10s objects:   %8.3f ms/frame  (%d vertices)\n", mode, objects.frame_ms, objects.vertices);
+    std::printf("%-10s store:     %8.3f ms/frame  (%d vertices, %.2fx)\n\n", mode, store.frame_ms, store.vertices,
+                objects.frame_ms / std::max(store.frame_ms, 1e-6));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rows = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels = nullptr;
+    int atlas_width = 0;
+    int atlas_height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &atlas_width, &atlas_height);
+
+    std::vector<bench::RowData> data(static_cast<std::size_t>(rows));
+    Panel panel("Bench", 900.0f, 600.0f);
+    panel.set_root_widget(bench::generate_tree(rows, &data));
+
+    WidgetStore store;
+    double build_ms = bench::best_of([&] { store.build(*panel.get_root_widget()); });
+    std::printf("Generated panel: %d rows, %zu widgets\n", rows, store.size());
+    std::printf("WidgetStore build:   %8.2f ms\n\n", build_ms);
+
+    Result flow_objects = run(panel, Panel::Storage::Objects, false);
+    Result flow_store = run(panel, Panel::Storage::DataOriented, false);
+    report("Flow", flow_objects, flow_store);
+
+    Result positioned_objects = run(panel, Panel::Storage::Objects, true);
+    Result positioned_store = run(panel, Panel::Storage::DataOriented, true);
+    report("Positioned", positioned_objects, positioned_store);
+
+    ImGui::DestroyContext();
+    return 0;
+}
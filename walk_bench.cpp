@@ -0,0 +1,169 @@
+#include "imgui.h"
+#include "bench_common.h"
+#include "Panel.h"
+#include "WidgetArena.h"
+#include "XmlParser.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Tree walk micro-benchmark on a generated 130k-widget panel
+ *
+ * Compares the RTTI-based walks used before widgets carried a WidgetKind
+ * (dynamic_cast at every node, four more per child container during
+ * validation, recursive id search) with the tag-based versions: layout
+ * validation, a full pre-order traversal and id lookups. Also times
+ * building and destroying the tree with widgets on the heap and in a
+ * WidgetArena; strings and Yoga nodes are on the heap in both runs, so
+ * the difference is the per-widget allocation alone.
+ *
+ * Usage: widget_walk_bench [rows]   (default 10000 rows, ~130k widgets)
+ */
+
+namespace {
+
+constexpr int kLookups = 200;
+
+// Validation as done before: dynamic_cast per child, four more per child container
+bool validate_legacy(Widget* widget, std::string& error_message) {
+    ContainerWidget* container = dynamic_cast<ContainerWidget*>(widget);
+    if (container) {
+        for (const auto& child : container->get_children()) {
+            ContainerWidget* child_container = dynamic_cast<ContainerWidget*>(child.get());
+            if (child_container) {
+                HLayoutWidget* parent_hlayout = dynamic_cast<HLayoutWidget*>(container);
+                VLayoutWidget* parent_vlayout = dynamic_cast<VLayoutWidget*>(container);
+                HLayoutWidget* child_hlayout = dynamic_cast<HLayoutWidget*>(child.get());
+                VLayoutWidget* child_vlayout = dynamic_cast<VLayoutWidget*>(child.get());
+                if ((parent_hlayout && child_hlayout) || (parent_vlayout && child_vlayout)) {
+                    error_message = "same-type nesting";
+                    return false;
+                }
+                if (!validate_legacy(child.get(), error_message)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Traversal as done before: dynamic_cast at every node
+void count_legacy(Widget* widget, std::size_t& widgets, std::size_t& inputs) {
+    ++widgets;
+    if (dynamic_cast<InputNumberWidget*>(widget)) {
+        ++inputs;
+    }
+    if (auto* container = dynamic_cast<ContainerWidget*>(widget)) {
+        for (const auto& child : container->get_children()) {
+            count_legacy(child.get(), widgets, inputs);
+        }
+    }
+}
+
+// Lookup as done before: recursive search with a dynamic_cast per node
+Widget* find_legacy(Widget* widget, const std::string& id) {
+    if (auto* container = dynamic_cast<ContainerWidget*>(widget)) {
+        for (const auto& child : container->get_children()) {
+            if (child->get_id() == id) {
+                return child.get();
+            }
+            if (Widget* found = find_legacy(child.get(), id)) {
+                return found;
+            }
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rows = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10000;
+
+    ImGui::CreateContext();
+
+    Panel panel("Bench", 900.0f, 600.0f);
+    panel.set_root_widget(bench::generate_tree(rows));
+    Widget* root = panel.get_root_widget();
+
+    std::size_t widget_count = 0;
+    walk_widgets(*root, [&](Widget&) {
+        ++widget_count;
+        return true;
+    });
+    std::printf("Generated panel: %d rows, %zu widgets\n\n", rows, widget_count);
+
+    std::vector<std::string> ids;
+    for (int i = 0; i < kLookups; ++i) {
+        ids.push_back("temp_" + std::to_string(static_cast<long long>(i) * rows / kLookups));
+    }
+
+    std::string error_message;
+    volatile std::size_t sink = 0;
+
+    double validate_rtti_ms = bench::best_of([&] { sink = sink + validate_legacy(root, error_message); });
+    double validate_tag_ms = bench::best_of([&] { sink = sink + XmlParser::validate_layout_hierarchy(root, error_message); });
+    std::printf("Layout validation (dynamic_cast):     %8.2f ms\n", validate_rtti_ms);
+    std::printf("Layout validation (WidgetKind):       %8.2f ms  (%.1fx)\n\n", validate_tag_ms,
+                validate_rtti_ms / validate_tag_ms);
+
+    double walk_rtti_ms = bench::best_of([&] {
+        std::size_t widgets = 0;
+        std::size_t inputs = 0;
+        count_legacy(root, widgets, inputs);
+        sink = sink + widgets + inputs;
+    });
+    double walk_tag_ms = bench::best_of([&] {
+        std::size_t widgets = 0;
+        std::size_t inputs = 0;
+        walk_widgets(*root, [&](Widget& widget) {
+            ++widgets;
+            if (widget_cast<InputNumberWidget>(&widget)) {
+                ++inputs;
+            }
+            return true;
+        });
+        sink = sink + widgets + inputs;
+    });
+    std::printf("Pre-order walk (dynamic_cast):        %8.2f ms\n", walk_rtti_ms);
+    std::printf("Pre-order walk (walk_widgets):        %8.2f ms  (%.1fx)\n\n", walk_tag_ms,
+                walk_rtti_ms / walk_tag_ms);
+
+    double find_rtti_ms = bench::best_of([&] {
+        for (const auto& id : ids) {
+            sink = sink + (dynamic_cast<InputNumberWidget*>(find_legacy(root, id)) != nullptr);
+        }
+    });
+    double find_index_ms = bench::best_of([&] {
+        for (const auto& id : ids) {
+            sink = sink + (panel.find_widget_as<InputNumberWidget>(id) != nullptr);
+        }
+    });
+    std::printf("%d typed lookups (recursive search):  %8.2f ms\n", kLookups, find_rtti_ms);
+    std::printf("%d typed lookups (WidgetIndex):       %8.4f ms  (%.0fx)\n", kLookups, find_index_ms,
+                find_rtti_ms / std::max(find_index_ms, 1e-6));
+
+    double heap_ms = bench::best_of([&] { bench::generate_tree(rows).reset(); });
+    WidgetArena::Stats arena_stats;
+    double arena_ms = bench::best_of([&] {
+        auto arena = WidgetArena::create();
+        std::unique_ptr<Widget> tree;
+        {
+            WidgetArena::Scope scope(arena.get());
+            tree = bench::generate_tree(rows);
+        }
+        arena_stats = arena->get_stats();
+        tree.reset();
+    });
+    std::printf("\nBuild + teardown (heap):             %8.2f ms\n", heap_ms);
+    std::printf("Build + teardown (WidgetArena):      %8.2f ms  (%.2fx, %zu widget shells in %zu blocks)\n", arena_ms,
+                heap_ms / arena_ms, arena_stats.allocations, arena_stats.blocks);
+
+    ImGui::DestroyContext();
+    return 0;
+}